@@ -17,15 +17,37 @@ DEFINES += QT_DEPRECATED_WARNINGS
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
 SOURCES += \
+    asynclogger.cpp \
+    capturefile.cpp \
+    capturereplay.cpp \
+    eventlog.cpp \
+    logarchive.cpp \
+    logtimestamp.cpp \
     main.cpp \
     mainwindow.cpp \
     qcustomplot.cpp \
+    receivebuffer.cpp \
+    replotscheduler.cpp \
     serialporthandler.cpp
 
 HEADERS += \
+    asynclogger.h \
+    autoscale.h \
+    capturefile.h \
+    capturereplay.h \
+    eventlog.h \
+    frameparser.h \
+    ingeststats.h \
+    jigprotocol.h \
+    logarchive.h \
+    logtimestamp.h \
     mainwindow.h \
+    mpscqueue.h \
     qcustomplot.h \
-    serialporthandler.h
+    receivebuffer.h \
+    replotscheduler.h \
+    serialporthandler.h \
+    spscring.h
 
 FORMS += \
     mainwindow.ui
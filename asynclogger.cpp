@@ -0,0 +1,400 @@
+#include "asynclogger.h"
+#include "logarchive.h"
+#include <QDateTime>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QtEndian>
+#include <cstring>
+
+namespace
+{
+    class compressJob : public QRunnable
+    {
+    public:
+        compressJob(const QString &segment, const QString &liveFile, qint64 maxArchiveBytes)
+            : segment(segment), liveFile(liveFile), maxArchiveBytes(maxArchiveBytes) {}
+
+        void run() override
+        {
+            if(!logArchive::compress(segment))
+            {
+                qWarning() << "Failed to compress log segment" << segment;
+            }
+            if(maxArchiveBytes > 0)
+            {
+                logArchive::prune(liveFile, maxArchiveBytes);
+            }
+        }
+
+    private:
+        QString segment;
+        QString liveFile;
+        qint64 maxArchiveBytes;
+    };
+}
+
+asyncLogger::asyncLogger(QObject *parent) : QThread(parent)
+  , queue(QueueCapacity)
+  , textBytes(0)
+  , events(QueueCapacity)
+  , eventBytes(0)
+  , opened(false)
+  , eventsOpened(false)
+  , stopping(false)
+  , dropped(0)
+  , droppedEventCount(0)
+  , flushRequested(0)
+  , flushCompleted(0)
+{
+    setObjectName("asyncLogger");
+
+    //One at a time, so archives are pruned in the order they were written
+    compressor.setMaxThreadCount(1);
+}
+
+asyncLogger::~asyncLogger()
+{
+    shutdown();
+}
+
+bool asyncLogger::open(const QString &fileName, const QString &eventFileName)
+{
+    shutdown();
+
+    clock.start();
+
+    archiveExisting(fileName);
+    file.setFileName(fileName);
+    if(!file.open(QIODevice::Append | QIODevice::Text))
+    {
+        qCritical() << "Failed to open log file.";
+        return false;
+    }
+    textBytes = file.size();
+
+    if(!eventFileName.isEmpty())
+    {
+        archiveExisting(eventFileName);
+        eventFile.setFileName(eventFileName);
+        if(eventFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            uchar header[eventLog::HeaderSize];
+            memcpy(header, eventLog::Magic, sizeof(eventLog::Magic));
+            qToLittleEndian<quint64>(static_cast<quint64>(clock.anchorMs()), header + 8);
+            eventHeader = QByteArray(reinterpret_cast<const char *>(header), sizeof(header));
+            eventFile.write(eventHeader);
+            eventBytes = eventHeader.size();
+            eventsOpened.store(true, std::memory_order_release);
+        }
+        else
+        {
+            qCritical() << "Failed to open event log file.";
+        }
+    }
+
+    batch.reserve(BatchBytes * 2);
+    eventBatch.reserve(BatchBytes * 2);
+    segmentClock.start();
+    stopping.store(false, std::memory_order_release);
+    opened.store(true, std::memory_order_release);
+    start(QThread::LowPriority);
+    return true;
+}
+
+void asyncLogger::log(const QString &line)
+{
+    if(!isOpen())
+    {
+        qCritical() << "Log file is not open.";
+        return;
+    }
+
+    entry e;
+    e.wallMs = clock.nowMs();
+    e.text = line;
+    if(!queue.push(std::move(e)))
+    {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    //Lost wake-ups only delay the batch until FlushIntervalMs
+    if(queue.sizeApprox() >= WakeThreshold)
+    {
+        wake.wakeOne();
+    }
+}
+
+void asyncLogger::logEvent(quint16 eventId, quint8 msgId, const void *payload, int len)
+{
+    if(!eventsOpened.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    eventLog::record r;
+    eventLog::fill(r, static_cast<quint64>(clock.nowNs()), eventId, msgId, payload, len);
+    if(!events.push(r))
+    {
+        droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if(events.sizeApprox() >= WakeThreshold)
+    {
+        wake.wakeOne();
+    }
+}
+
+void asyncLogger::flush()
+{
+    if(!isRunning())
+    {
+        return;
+    }
+
+    QMutexLocker locker(&wakeMutex);
+    const quint64 ticket = flushRequested.fetch_add(1, std::memory_order_acq_rel) + 1;
+    wake.wakeOne();
+    while(flushCompleted.load(std::memory_order_acquire) < ticket && isRunning())
+    {
+        flushed.wait(&wakeMutex, FlushIntervalMs);
+    }
+}
+
+void asyncLogger::shutdown()
+{
+    if(isRunning())
+    {
+        {
+            QMutexLocker locker(&wakeMutex);
+            stopping.store(true, std::memory_order_release);
+            wake.wakeOne();
+        }
+        wait();
+    }
+
+    opened.store(false, std::memory_order_release);
+    eventsOpened.store(false, std::memory_order_release);
+    if(file.isOpen())
+    {
+        file.close();
+    }
+    if(eventFile.isOpen())
+    {
+        eventFile.close();
+    }
+
+    //Segments closed so far are compressed before returning
+    compressor.waitForDone();
+}
+
+void asyncLogger::append(const entry &e)
+{
+    char stamp[timestampFormatter::Length];
+    stamps.format(e.wallMs, stamp);
+
+    batch.append('[');
+    batch.append(stamp, timestampFormatter::Length);
+    batch.append("] ");
+    batch.append(e.text.toUtf8());
+    batch.append('\n');
+}
+
+void asyncLogger::writeText()
+{
+    if(rotationDue(batch.size(), 0))
+    {
+        rotate();
+    }
+    file.write(batch);
+    textBytes += batch.size();
+    batch.resize(0);
+}
+
+void asyncLogger::writeEvents()
+{
+    if(rotationDue(0, eventBatch.size()))
+    {
+        rotate();
+    }
+    if(eventFile.isOpen())
+    {
+        eventFile.write(eventBatch);
+        eventBytes += eventBatch.size();
+    }
+    eventBatch.resize(0);
+}
+
+void asyncLogger::writeBatch()
+{
+    if(rotationDue(batch.size(), eventBatch.size()))
+    {
+        rotate();
+    }
+
+    if(!batch.isEmpty())
+    {
+        writeText();
+    }
+    file.flush();
+
+    if(!eventBatch.isEmpty())
+    {
+        writeEvents();
+    }
+    if(eventFile.isOpen())
+    {
+        eventFile.flush();
+    }
+}
+
+bool asyncLogger::rotationDue(qint64 textPending, qint64 eventPending) const
+{
+    const bool hasText = textBytes > 0;
+    const bool hasEvents = eventBytes > eventHeader.size();
+    if(!hasText && !hasEvents)
+    {
+        return false;
+    }
+
+    if(rotation.maxSegmentAgeMs > 0 && segmentClock.elapsed() >= rotation.maxSegmentAgeMs)
+    {
+        return true;
+    }
+    return rotation.maxSegmentBytes > 0
+            && ((hasText && textBytes + textPending > rotation.maxSegmentBytes)
+                || (hasEvents && eventBytes + eventPending > rotation.maxSegmentBytes));
+}
+
+void asyncLogger::rotate()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+
+    closeSegment(file, now);
+    if(!file.open(QIODevice::Append | QIODevice::Text))
+    {
+        qCritical() << "Failed to reopen log file.";
+        opened.store(false, std::memory_order_release);
+    }
+    textBytes = 0;
+
+    if(eventFile.isOpen())
+    {
+        closeSegment(eventFile, now);
+        if(eventFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            eventFile.write(eventHeader);
+        }
+        else
+        {
+            qCritical() << "Failed to reopen event log file.";
+            eventsOpened.store(false, std::memory_order_release);
+        }
+        eventBytes = eventHeader.size();
+    }
+
+    segmentClock.restart();
+}
+
+void asyncLogger::closeSegment(QFile &live, const QDateTime &when)
+{
+    live.flush();
+    live.close();
+
+    const QString segment = logArchive::segmentName(live.fileName(), when);
+    if(QFile::rename(live.fileName(), segment))
+    {
+        compressor.start(new compressJob(segment, live.fileName(), rotation.maxArchiveBytes));
+    }
+}
+
+void asyncLogger::archiveExisting(const QString &liveFile)
+{
+    const QFileInfo info(liveFile);
+    if(info.exists() && info.size() > 0)
+    {
+        QFile::rename(liveFile, logArchive::segmentName(liveFile, info.lastModified()));
+    }
+
+    //Including any a previous run closed but did not get to compress
+    for(const QString &segment : logArchive::pendingSegments(liveFile))
+    {
+        compressor.start(new compressJob(segment, liveFile, rotation.maxArchiveBytes));
+    }
+}
+
+void asyncLogger::run()
+{
+    QElapsedTimer sinceWrite;
+    sinceWrite.start();
+    quint64 reportedDrops = 0;
+    quint64 reportedEventDrops = 0;
+    entry e;
+    eventLog::record r;
+
+    for(;;)
+    {
+        //Read the request before draining, so every line logged before flush() is included
+        const quint64 flushWanted = flushRequested.load(std::memory_order_acquire);
+        const bool stop = stopping.load(std::memory_order_acquire);
+
+        while(queue.pop(e))
+        {
+            append(e);
+            if(batch.size() >= BatchBytes)
+            {
+                writeText();
+            }
+        }
+
+        while(events.pop(r))
+        {
+            eventLog::encode(r, eventBatch);
+            if(eventBatch.size() >= BatchBytes)
+            {
+                writeEvents();
+            }
+        }
+
+        const quint64 drops = dropped.load(std::memory_order_relaxed);
+        if(drops != reportedDrops)
+        {
+            batch.append(QString("[logger] %1 lines dropped, queue full\n").arg(drops - reportedDrops).toUtf8());
+            reportedDrops = drops;
+        }
+        const quint64 eventDrops = droppedEventCount.load(std::memory_order_relaxed);
+        if(eventDrops != reportedEventDrops)
+        {
+            batch.append(QString("[logger] %1 events dropped, queue full\n").arg(eventDrops - reportedEventDrops).toUtf8());
+            reportedEventDrops = eventDrops;
+        }
+
+        const bool flushDue = flushWanted != flushCompleted.load(std::memory_order_relaxed);
+        const bool pending = !batch.isEmpty() || !eventBatch.isEmpty();
+        if(stop || flushDue || batch.size() >= BatchBytes
+                || (pending && sinceWrite.elapsed() >= FlushIntervalMs))
+        {
+            writeBatch();
+            sinceWrite.restart();
+        }
+
+        QMutexLocker locker(&wakeMutex);
+        if(flushDue)
+        {
+            flushCompleted.store(flushWanted, std::memory_order_release);
+            flushed.wakeAll();
+        }
+        if(stop)
+        {
+            break;
+        }
+        if(queue.sizeApprox() == 0 && events.sizeApprox() == 0 && flushRequested.load(std::memory_order_acquire) == flushCompleted.load(std::memory_order_relaxed)
+                && !stopping.load(std::memory_order_acquire))
+        {
+            wake.wait(&wakeMutex, FlushIntervalMs);
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#ifndef ASYNCLOGGER_H
+#define ASYNCLOGGER_H
+
+#include <QThread>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QString>
+#include <QElapsedTimer>
+#include <QThreadPool>
+#include <atomic>
+#include "mpscqueue.h"
+#include "eventlog.h"
+#include "logtimestamp.h"
+
+// Background writer for debug_notes.txt.
+//
+// log() may be called from any thread and only takes a timestamp and pushes
+// onto a lock-free queue. The logger thread formats the lines, collects them
+// into batches and writes a batch once it reaches BatchBytes or has waited
+// FlushIntervalMs, so a fast acquisition costs a handful of write() calls per
+// second instead of one per line. flush() blocks until everything logged so
+// far is on disk; shutdown() drains the queue, flushes and stops the thread.
+// If the queue is full the line is dropped and counted rather than blocking
+// the caller.
+//
+// logEvent() is the binary counterpart for frames and hex dumps: it copies
+// the raw bytes into a fixed-size record and the logger thread appends it to
+// the event log (eventlog.h) instead of formatting text.
+//
+// Both files are rotated together once either passes maxSegmentBytes or the
+// segment is maxSegmentAgeMs old. A closed segment is renamed aside and a
+// pool thread compresses it (logarchive.h), so the logger thread never waits
+// on zlib; old archives are pruned to maxArchiveBytes per file. open() closes
+// whatever a previous run left in the live files the same way, so restarting
+// the application keeps the history.
+class asyncLogger : public QThread
+{
+public:
+    enum
+    {
+        QueueCapacity = 1 << 14,
+        BatchBytes = 64 * 1024,
+        FlushIntervalMs = 200,
+        WakeThreshold = 1024 //queued lines before an early wake-up
+    };
+
+    //0 disables a limit
+    struct rotationPolicy
+    {
+        rotationPolicy() : maxSegmentBytes(16 << 20), maxSegmentAgeMs(60 * 60 * 1000), maxArchiveBytes(256 << 20) {}
+
+        qint64 maxSegmentBytes;
+        qint64 maxSegmentAgeMs;
+        qint64 maxArchiveBytes;
+    };
+
+    explicit asyncLogger(QObject *parent = nullptr);
+    ~asyncLogger() override;
+
+    //eventFileName may be empty, logEvent() is then a no-op
+    bool open(const QString &fileName, const QString &eventFileName = QString());
+    bool isOpen() const { return opened.load(std::memory_order_acquire); }
+
+    //Takes effect at the next open()
+    void setRotation(const rotationPolicy &policy) { rotation = policy; }
+
+    void log(const QString &line);
+    void logEvent(quint16 eventId, quint8 msgId, const void *payload, int len);
+
+    void flush();
+    void shutdown();
+
+    quint64 droppedLines() const { return dropped.load(std::memory_order_relaxed); }
+    quint64 droppedEvents() const { return droppedEventCount.load(std::memory_order_relaxed); }
+
+protected:
+    void run() override;
+
+private:
+    struct entry
+    {
+        qint64 wallMs;
+        QString text;
+    };
+
+    void append(const entry &e);
+    void writeText();
+    void writeEvents();
+    void writeBatch();
+
+    bool rotationDue(qint64 textPending, qint64 eventPending) const;
+    void rotate();
+    void closeSegment(QFile &live, const QDateTime &when);
+    void archiveExisting(const QString &liveFile);
+
+    mpscQueue<entry> queue;
+    QFile file;
+    QByteArray batch;
+    qint64 textBytes;
+
+    mpscQueue<eventLog::record> events;
+    QFile eventFile;
+    QByteArray eventBatch;
+    QByteArray eventHeader; //repeated at the start of every segment
+    qint64 eventBytes;
+
+    //Both files are stamped from one monotonic clock, anchored at open()
+    logClock clock;
+    timestampFormatter stamps;
+
+    rotationPolicy rotation;
+    QElapsedTimer segmentClock;
+    QThreadPool compressor;
+
+    std::atomic<bool> opened;
+    std::atomic<bool> eventsOpened;
+    std::atomic<bool> stopping;
+    std::atomic<quint64> dropped;
+    std::atomic<quint64> droppedEventCount;
+
+    QMutex wakeMutex;
+    QWaitCondition wake;
+    QWaitCondition flushed;
+    std::atomic<quint64> flushRequested;
+    std::atomic<quint64> flushCompleted;
+};
+
+#endif // ASYNCLOGGER_H
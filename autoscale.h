@@ -0,0 +1,139 @@
+#ifndef AUTOSCALE_H
+#define AUTOSCALE_H
+
+#include <QtGlobal>
+#include <deque>
+
+// Min/max of the last window() samples, pushed in index order.
+//
+// Two monotonic deques hold only the samples that can still become the
+// minimum or maximum: a new sample removes every older one it beats, and the
+// front drops out when it leaves the window. Each sample is added and
+// removed at most once, so push() is amortized O(1) and min()/max() are O(1).
+class windowedMinMax
+{
+public:
+    explicit windowedMinMax(qint64 window = 0) : span(window) {}
+
+    void setWindow(qint64 window) { span = window; clear(); }
+    qint64 window() const { return span; }
+
+    void clear()
+    {
+        lows.clear();
+        highs.clear();
+    }
+
+    bool isEmpty() const { return lows.empty(); }
+
+    void push(qint64 index, double value)
+    {
+        while(!lows.empty() && lows.back().value >= value)
+            lows.pop_back();
+        lows.push_back(entry(index, value));
+
+        while(!highs.empty() && highs.back().value <= value)
+            highs.pop_back();
+        highs.push_back(entry(index, value));
+
+        const qint64 oldest = index - span;
+        while(lows.front().index <= oldest)
+            lows.pop_front();
+        while(highs.front().index <= oldest)
+            highs.pop_front();
+    }
+
+    //Only valid when !isEmpty()
+    double min() const { return lows.front().value; }
+    double max() const { return highs.front().value; }
+
+private:
+    struct entry
+    {
+        entry(qint64 index, double value) : index(index), value(value) {}
+        qint64 index;
+        double value;
+    };
+
+    qint64 span;
+    std::deque<entry> lows;  //increasing values
+    std::deque<entry> highs; //decreasing values
+};
+
+// Min/max of every sample since the last clear(), O(1) per sample.
+class runningMinMax
+{
+public:
+    runningMinMax() : empty(true), lowest(0.0), highest(0.0) {}
+
+    void clear() { empty = true; }
+
+    bool isEmpty() const { return empty; }
+
+    void push(double value)
+    {
+        if(empty || value < lowest)
+            lowest = value;
+        if(empty || value > highest)
+            highest = value;
+        empty = false;
+    }
+
+    //Only valid when !isEmpty()
+    double min() const { return lowest; }
+    double max() const { return highest; }
+
+private:
+    bool empty;
+    double lowest;
+    double highest;
+};
+
+// Decides when a value axis has to move, with hysteresis.
+//
+// The axis is fitted to the data plus headroom on both sides. It grows as
+// soon as the data leaves it, but only shrinks back once the data uses less
+// than shrinkBelow of it, so small changes from frame to frame leave the axis
+// (and the tick labels and layout) alone.
+class axisAutoscaler
+{
+public:
+    explicit axisAutoscaler(double headroom = 0.05, double shrinkBelow = 0.5)
+        : margin(headroom), shrinkRatio(shrinkBelow), valid(false), lo(0.0), hi(0.0) {}
+
+    void reset() { valid = false; }
+
+    //Returns true when lower()/upper() changed
+    bool update(double dataMin, double dataMax)
+    {
+        double span = dataMax - dataMin;
+        if(span <= 0.0)
+        {
+            //Flat signal: a small band around it instead of an empty range
+            span = qMax(qAbs(dataMax), 1.0) * 1e-3;
+        }
+
+        //Measured against the span the axis is fitted to, so a flat signal settles too
+        if(valid && dataMin >= lo && dataMax <= hi && span >= shrinkRatio * (hi - lo))
+        {
+            return false;
+        }
+
+        lo = dataMin - span * margin;
+        hi = dataMax + span * margin;
+        valid = true;
+        return true;
+    }
+
+    double lower() const { return lo; }
+    double upper() const { return hi; }
+
+private:
+    double margin;
+    double shrinkRatio;
+    bool valid;
+    double lo;
+    double hi;
+};
+
+#endif // AUTOSCALE_H
@@ -0,0 +1,22 @@
+# Micro-benchmark for the adaptive sampling of QCPGraph::getOptimizedLineData: the scalar
+# loop it used before against the vectorized one, in data points per second.
+# Build: qmake && make, then run ./linebench [--points N] [--width pixels]
+# For the AVX kernel instead of SSE2: qmake "QMAKE_CXXFLAGS += -mavx2"
+
+QT       += core gui widgets printsupport
+
+CONFIG += c++11 console release
+CONFIG -= app_bundle
+
+TARGET = linebench
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../qcustomplot.cpp
+
+HEADERS += \
+    ../../qcustomplot.h
@@ -0,0 +1,248 @@
+#include "qcustomplot.h"
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QTextStream>
+#include <random>
+
+namespace
+{
+    struct result
+    {
+        double pointsPerSecond;
+        int outputPoints;
+    };
+
+    //Exposes the line data preparation of QCPGraph
+    class benchGraph : public QCPGraph
+    {
+    public:
+        benchGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) : QCPGraph(keyAxis, valueAxis) {}
+
+        void lineData(QVector<QCPGraphData> *out) const
+        {
+            getOptimizedLineData(out, data()->constBegin(), data()->constEnd());
+        }
+
+        //The adaptive sampling of getOptimizedLineData() in the given number of shards,
+        //1 is the serial loop
+        void shardedLineData(QVector<QCPGraphData> *out, int shards) const
+        {
+            QCPAxis *keyAxis = mKeyAxis.data();
+            QCPGraphDataContainer::const_iterator begin = data()->constBegin();
+            QCPGraphDataContainer::const_iterator end = data()->constEnd();
+            const int reversedRound = keyAxis->pixelOrientation() == -1 ? 1 : 0;
+            const double firstKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(begin->key) + reversedRound));
+            const double keyEpsilon = qAbs(firstKey - keyAxis->pixelToCoord(keyAxis->coordToPixel(firstKey) + 1.0 * keyAxis->pixelOrientation()));
+            if(shards < 2 || !getParallelLineData(out, begin, end, keyEpsilon, shards))
+                getAdaptiveLineData(out, nullptr, begin, end, 0, int(end - begin), keyEpsilon);
+        }
+    };
+
+    //The adaptive sampling loop of QCPGraph::getOptimizedLineData before the vector kernel,
+    //one comparison per data point
+    void scalarLineData(QCPAxis *keyAxis, const QCPGraphDataContainer &data, QVector<QCPGraphData> *lineData)
+    {
+        QCPGraphDataContainer::const_iterator begin = data.constBegin();
+        QCPGraphDataContainer::const_iterator end = data.constEnd();
+        QCPGraphDataContainer::const_iterator it = begin;
+        double minValue = it->value;
+        double maxValue = it->value;
+        QCPGraphDataContainer::const_iterator currentIntervalFirstPoint = it;
+        int reversedFactor = keyAxis->pixelOrientation();
+        int reversedRound = reversedFactor == -1 ? 1 : 0;
+        double currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(begin->key) + reversedRound));
+        double lastIntervalEndKey = currentIntervalStartKey;
+        double keyEpsilon = qAbs(currentIntervalStartKey - keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey) + 1.0 * reversedFactor));
+        int intervalDataCount = 1;
+        ++it;
+        while(it != end)
+        {
+            if(it->key < currentIntervalStartKey + keyEpsilon)
+            {
+                if(it->value < minValue)
+                    minValue = it->value;
+                else if(it->value > maxValue)
+                    maxValue = it->value;
+                ++intervalDataCount;
+            }
+            else
+            {
+                if(intervalDataCount >= 2)
+                {
+                    if(lastIntervalEndKey < currentIntervalStartKey - keyEpsilon)
+                        lineData->append(QCPGraphData(currentIntervalStartKey + keyEpsilon * 0.2, currentIntervalFirstPoint->value));
+                    lineData->append(QCPGraphData(currentIntervalStartKey + keyEpsilon * 0.25, minValue));
+                    lineData->append(QCPGraphData(currentIntervalStartKey + keyEpsilon * 0.75, maxValue));
+                    if(it->key > currentIntervalStartKey + keyEpsilon * 2)
+                        lineData->append(QCPGraphData(currentIntervalStartKey + keyEpsilon * 0.8, (it - 1)->value));
+                }
+                else
+                    lineData->append(QCPGraphData(currentIntervalFirstPoint->key, currentIntervalFirstPoint->value));
+                lastIntervalEndKey = (it - 1)->key;
+                minValue = it->value;
+                maxValue = it->value;
+                currentIntervalFirstPoint = it;
+                currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(it->key) + reversedRound));
+                intervalDataCount = 1;
+            }
+            ++it;
+        }
+        if(intervalDataCount >= 2)
+        {
+            if(lastIntervalEndKey < currentIntervalStartKey - keyEpsilon)
+                lineData->append(QCPGraphData(currentIntervalStartKey + keyEpsilon * 0.2, currentIntervalFirstPoint->value));
+            lineData->append(QCPGraphData(currentIntervalStartKey + keyEpsilon * 0.25, minValue));
+            lineData->append(QCPGraphData(currentIntervalStartKey + keyEpsilon * 0.75, maxValue));
+        }
+        else
+            lineData->append(QCPGraphData(currentIntervalFirstPoint->key, currentIntervalFirstPoint->value));
+    }
+
+    template <class Prepare>
+    result run(int points, int runs, QVector<QCPGraphData> *out, Prepare prepare)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        for(int r = 0; r < runs; ++r)
+        {
+            out->clear();
+            prepare(out);
+        }
+        result res;
+        res.pointsPerSecond = double(points) * runs / (timer.nsecsElapsed() * 1e-9);
+        res.outputPoints = out->size();
+        return res;
+    }
+
+    bool sameLineData(const QVector<QCPGraphData> &a, const QVector<QCPGraphData> &b)
+    {
+        if(a.size() != b.size())
+            return false;
+        for(int i = 0; i < a.size(); ++i)
+        {
+            const bool sameValue = a.at(i).value == b.at(i).value || (qIsNaN(a.at(i).value) && qIsNaN(b.at(i).value));
+            if(a.at(i).key != b.at(i).key || !sameValue)
+                return false;
+        }
+        return true;
+    }
+
+    const char *kernelName()
+    {
+#if defined(QCP_NO_SIMD)
+        return "scalar";
+#elif defined(__AVX__)
+        return "AVX";
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
+    //speedup is against baseline, the one-thread run of the same kernel
+    void printRow(QTextStream &out, const QString &name, const result &res, const result &baseline)
+    {
+        out << qSetFieldWidth(28) << Qt::left << name << qSetFieldWidth(14) << Qt::right
+            << QString::number(res.pointsPerSecond / 1e6, 'f', 1)
+            << QString::number(res.pointsPerSecond / baseline.pointsPerSecond, 'f', 2)
+            << QString::number(res.outputPoints)
+            << qSetFieldWidth(0) << Qt::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption pointsOption("points", "Data points in the graph.", "count", "4000000");
+    QCommandLineOption widthOption("width", "Width of the axis rect in pixels.", "pixels", "1600");
+    QCommandLineOption runsOption("runs", "Repetitions per case.", "count", "20");
+    parser.addOption(pointsOption);
+    parser.addOption(widthOption);
+    parser.addOption(runsOption);
+    parser.process(a);
+
+    const int points = qMax(2, parser.value(pointsOption).toInt());
+    const int width = qMax(16, parser.value(widthOption).toInt());
+    const int runs = qMax(1, parser.value(runsOption).toInt());
+
+    //Random walk at a uniform rate with a few NaN gaps, like a long live capture
+    QCustomPlot plot;
+    plot.setViewport(QRect(0, 0, width + 100, 600));
+    benchGraph *graph = new benchGraph(plot.xAxis, plot.yAxis);
+    QVector<QCPGraphData> samples(points);
+    std::mt19937 rng(1);
+    std::normal_distribution<double> step(0.0, 1.0);
+    double walk = 0.0;
+    for(int i = 0; i < points; ++i)
+    {
+        walk += step(rng);
+        samples[i] = QCPGraphData(i, i % 100003 == 0 ? qQNaN() : walk);
+    }
+    graph->data()->set(samples, true);
+    plot.xAxis->setRange(0, points - 1);
+    plot.yAxis->setRange(-1000, 1000);
+
+    //Lay out the axis rect once without drawing the graph
+    graph->setVisible(false);
+    plot.replot();
+    graph->setVisible(true);
+
+    QVector<QCPGraphData> before, after;
+    bool same = true;
+    QTextStream out(stdout);
+    out << "points " << points << ", axis rect " << plot.axisRect()->width() << " px, kernel " << kernelName()
+        << ", " << QThread::idealThreadCount() << " threads" << Qt::endl;
+    out << qSetFieldWidth(28) << Qt::left << "case" << qSetFieldWidth(14) << Qt::right
+        << "Mpoints/s" << "speedup" << "line points" << qSetFieldWidth(0) << Qt::endl;
+
+    //Vector kernel against the scalar loop, both on one thread
+    const result scalar = run(points, runs, &before, [&](QVector<QCPGraphData> *lineData) {
+        scalarLineData(plot.xAxis, *graph->data(), lineData);
+    });
+    printRow(out, "scalar loop (before)", scalar, scalar);
+    const result serial = run(points, runs, &after, [&](QVector<QCPGraphData> *lineData) {
+        graph->shardedLineData(lineData, 1);
+    });
+    printRow(out, QString("%1 kernel, 1 thread").arg(kernelName()), serial, scalar);
+    same = same && sameLineData(before, after);
+
+    //Thread scaling of the sharded sampling, against the vector kernel on one thread
+    QVector<int> shardCounts;
+    for(int shards = 2; shards < QThread::idealThreadCount(); shards *= 2)
+        shardCounts << shards;
+    if(QThread::idealThreadCount() > 1)
+        shardCounts << QThread::idealThreadCount();
+    for(int shards : shardCounts)
+    {
+        printRow(out, QString("%1 shards").arg(shards), run(points, runs, &after, [&](QVector<QCPGraphData> *lineData) {
+            graph->shardedLineData(lineData, shards);
+        }), serial);
+        same = same && sameLineData(before, after);
+    }
+
+    //What the plot actually uses for this data and axis rect
+    printRow(out, "getOptimizedLineData", run(points, runs, &after, [&](QVector<QCPGraphData> *lineData) {
+        graph->lineData(lineData);
+    }), serial);
+    same = same && sameLineData(before, after);
+
+    //Level of detail index: buckets instead of points, the line data must not change
+    graph->data()->setLevelOfDetail(true);
+    graph->data()->levelOfDetailIndex(); //build it outside the measurement
+    printRow(out, "level of detail", run(points, runs, &after, [&](QVector<QCPGraphData> *lineData) {
+        graph->lineData(lineData);
+    }), serial);
+    same = same && sameLineData(before, after);
+    graph->data()->setLevelOfDetail(false);
+
+    out << "line data " << (same ? "identical" : "DIFFERENT") << Qt::endl;
+
+    return same ? 0 : 1;
+}
@@ -0,0 +1,21 @@
+# Micro-benchmark for log line timestamps: QDateTime::toString() against timestampFormatter.
+# Build: qmake && make, then run ./logbench [--stamps N]
+
+QT       += core
+QT       -= gui
+
+CONFIG += c++11 console release
+CONFIG -= app_bundle
+
+TARGET = logbench
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../logtimestamp.cpp
+
+HEADERS += \
+    ../../logtimestamp.h
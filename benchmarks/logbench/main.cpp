@@ -0,0 +1,132 @@
+#include "logtimestamp.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <cstring>
+
+namespace
+{
+    struct result
+    {
+        double nsPerStamp;
+        quint64 stamps;
+    };
+
+    //Keeps the compiler from dropping the formatted text
+    quint64 checksum = 0;
+
+    //What writeToNotes() did per line before the logger thread existed
+    result runQDateTime(int stamps)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        for(int i = 0; i < stamps; ++i)
+        {
+            const QByteArray text = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz").toUtf8();
+            checksum += static_cast<uchar>(text.at(text.size() - 1));
+        }
+        result res;
+        res.stamps = static_cast<quint64>(stamps);
+        res.nsPerStamp = double(timer.nsecsElapsed()) / stamps;
+        return res;
+    }
+
+    //What asyncLogger does: anchored monotonic clock plus the cached prefix
+    result runCached(int stamps)
+    {
+        logClock clock;
+        clock.start();
+        timestampFormatter formatter;
+        char text[timestampFormatter::Length];
+
+        QElapsedTimer timer;
+        timer.start();
+        for(int i = 0; i < stamps; ++i)
+        {
+            formatter.format(clock.nowMs(), text);
+            checksum += static_cast<uchar>(text[timestampFormatter::Length - 1]);
+        }
+        result res;
+        res.stamps = static_cast<quint64>(stamps);
+        res.nsPerStamp = double(timer.nsecsElapsed()) / stamps;
+        return res;
+    }
+
+    //Formatting alone, with a timestamp crossing a minute every 60000 stamps
+    result runFormatOnly(int stamps)
+    {
+        timestampFormatter formatter;
+        char text[timestampFormatter::Length];
+        const qint64 start = QDateTime::currentMSecsSinceEpoch();
+
+        QElapsedTimer timer;
+        timer.start();
+        for(int i = 0; i < stamps; ++i)
+        {
+            formatter.format(start + i, text);
+            checksum += static_cast<uchar>(text[timestampFormatter::Length - 1]);
+        }
+        result res;
+        res.stamps = static_cast<quint64>(stamps);
+        res.nsPerStamp = double(timer.nsecsElapsed()) / stamps;
+        return res;
+    }
+
+    //Compares against QDateTime across minute and hour boundaries
+    int countMismatches(int stamps)
+    {
+        timestampFormatter formatter;
+        char text[timestampFormatter::Length];
+        const qint64 start = QDateTime::currentMSecsSinceEpoch();
+        int mismatches = 0;
+        for(int i = 0; i < stamps; ++i)
+        {
+            //Steps of 7919 ms reach new minutes and hours quickly, and sometimes go back
+            const qint64 wallMs = start + qint64(i) * 7919 - (i % 5 == 0 ? 61000 : 0);
+            formatter.format(wallMs, text);
+            const QByteArray expected = QDateTime::fromMSecsSinceEpoch(wallMs).toString("yyyy-MM-dd HH:mm:ss.zzz").toLatin1();
+            if(expected.size() != timestampFormatter::Length || memcmp(expected.constData(), text, timestampFormatter::Length) != 0)
+            {
+                ++mismatches;
+            }
+        }
+        return mismatches;
+    }
+
+    void printRow(QTextStream &out, const QString &name, const result &res)
+    {
+        out << qSetFieldWidth(28) << Qt::left << name << qSetFieldWidth(12) << Qt::right
+            << QString::number(res.nsPerStamp, 'f', 1)
+            << QString::number(res.stamps)
+            << qSetFieldWidth(0) << Qt::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption stampsOption("stamps", "Timestamps per case.", "count", "1000000");
+    parser.addOption(stampsOption);
+    parser.process(a);
+
+    const int stamps = qMax(1, parser.value(stampsOption).toInt());
+
+    QTextStream out(stdout);
+    out << qSetFieldWidth(28) << Qt::left << "case" << qSetFieldWidth(12) << Qt::right
+        << "ns/stamp" << "stamps" << qSetFieldWidth(0) << Qt::endl;
+
+    printRow(out, "QDateTime::toString", runQDateTime(stamps));
+    printRow(out, "logClock + formatter", runCached(stamps));
+    printRow(out, "formatter only", runFormatOnly(stamps));
+
+    const int mismatches = countMismatches(qMin(stamps, 100000));
+    out << "mismatches against QDateTime: " << mismatches << " (checksum " << checksum % 10 << ")" << Qt::endl;
+
+    return mismatches == 0 ? 0 : 1;
+}
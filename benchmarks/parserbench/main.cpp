@@ -0,0 +1,355 @@
+#include "serialporthandler.h"
+#include "capturefile.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every heap allocation in the process goes through here so the hot path can
+// be checked for allocations per frame.
+namespace
+{
+    std::atomic<quint64> allocationCount(0);
+}
+
+void *operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if(void *p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void *p) noexcept
+{
+    std::free(p);
+}
+
+namespace
+{
+    //Keep message formatting in the measurement but not the console I/O
+    void discardMessages(QtMsgType, const QMessageLogContext &, const QString &)
+    {
+    }
+
+    QByteArray syntheticLiveStream(int frames)
+    {
+        QByteArray stream;
+        stream.reserve(frames * 6 + 3);
+        for(int i = 0; i < frames; ++i)
+        {
+            const quint16 word0 = static_cast<quint16>(16384 + (i * 37) % 12000);
+            const quint16 words[3] = {word0, static_cast<quint16>(i), static_cast<quint16>(~i)};
+            for(quint16 w : words)
+            {
+                stream.append(static_cast<char>(w >> 8));
+                stream.append(static_cast<char>(w & 0xff));
+            }
+        }
+        stream.append(QByteArray::fromHex("ffddff"));
+        return stream;
+    }
+
+    QByteArray powerFrame()
+    {
+        QByteArray frame = QByteArray::fromHex("5401" "0a3c" "0b12" "0612" "0abc" "0a00" "05ff" "0900");
+        quint8 chk = 0;
+        for(char c : frame)
+        {
+            chk ^= static_cast<quint8>(c);
+        }
+        frame.append(static_cast<char>(chk));
+        return frame;
+    }
+
+    QVector<captureReader::record> loadCapture(const QString &fileName)
+    {
+        QVector<captureReader::record> records;
+        captureReader reader;
+        if(!reader.open(fileName))
+        {
+            return records;
+        }
+        captureReader::record rec;
+        while(reader.next(rec))
+        {
+            records.append(rec);
+        }
+        return records;
+    }
+
+    struct result
+    {
+        double nsPerFrame;
+        double megabytesPerSecond;
+        double allocationsPerFrame;
+        quint64 frames;
+    };
+
+    //Feeds stream through injectBytes() in burst-sized pieces and drains the
+    //live ring after every burst, like the GUI would
+    int diagnosticsMode = serialPortHandler::DiagnosticsSummary;
+
+    result runLive(const QByteArray &stream, int burst, int repeats)
+    {
+        serialPortHandler handler;
+        handler.setDiagnosticsMode(diagnosticsMode);
+        quint64 batchedFrames = 0;
+        handler.setFrameBatchHandler([&batchedFrames](const frameBatch &batch) { batchedFrames += batch.count; });
+
+        std::vector<liveFrame> drain(serialPortHandler::MaxBatchFrames);
+
+        QElapsedTimer timer;
+        quint64 allocations = 0;
+        qint64 elapsedNs = 0;
+
+        for(int r = 0; r < repeats; ++r)
+        {
+            handler.recvMsgId(0x01);
+
+            const quint64 allocBefore = allocationCount.load();
+            timer.start();
+            for(int pos = 0; pos < stream.size(); pos += burst)
+            {
+                handler.injectBytes(stream.constData() + pos, qMin(burst, stream.size() - pos));
+                handler.rearmLiveNotify();
+                while(handler.liveRing().pop(drain.data(), drain.size()) > 0)
+                {
+                }
+            }
+            elapsedNs += timer.nsecsElapsed();
+            allocations += allocationCount.load() - allocBefore;
+        }
+
+        result res;
+        res.frames = batchedFrames;
+        res.nsPerFrame = batchedFrames ? double(elapsedNs) / batchedFrames : 0.0;
+        res.megabytesPerSecond = elapsedNs ? (double(stream.size()) * repeats / 1e6) / (elapsedNs / 1e9) : 0.0;
+        res.allocationsPerFrame = batchedFrames ? double(allocations) / batchedFrames : 0.0;
+        return res;
+    }
+
+    //Feeds a capture with its recorded read boundaries and msgId changes
+    result runCapture(const QVector<captureReader::record> &records, int repeats)
+    {
+        serialPortHandler handler;
+        handler.setDiagnosticsMode(diagnosticsMode);
+        quint64 batchedFrames = 0;
+        handler.setFrameBatchHandler([&batchedFrames](const frameBatch &batch) { batchedFrames += batch.count; });
+
+        std::vector<liveFrame> drain(serialPortHandler::MaxBatchFrames);
+
+        QElapsedTimer timer;
+        quint64 allocations = 0;
+        quint64 bytes = 0;
+        qint64 elapsedNs = 0;
+
+        for(int r = 0; r < repeats; ++r)
+        {
+            const quint64 allocBefore = allocationCount.load();
+            timer.start();
+            for(const captureReader::record &rec : records)
+            {
+                if(rec.kind == captureFormat::RecordMsgId && rec.payload.size() == 1)
+                {
+                    handler.recvMsgId(static_cast<quint8>(rec.payload.at(0)));
+                    continue;
+                }
+                handler.injectBytes(rec.payload.constData(), rec.payload.size());
+                bytes += static_cast<quint64>(rec.payload.size());
+                handler.rearmLiveNotify();
+                while(handler.liveRing().pop(drain.data(), drain.size()) > 0)
+                {
+                }
+            }
+            elapsedNs += timer.nsecsElapsed();
+            allocations += allocationCount.load() - allocBefore;
+        }
+
+        result res;
+        res.frames = batchedFrames;
+        res.nsPerFrame = batchedFrames ? double(elapsedNs) / batchedFrames : 0.0;
+        res.megabytesPerSecond = elapsedNs ? (double(bytes) / 1e6) / (elapsedNs / 1e9) : 0.0;
+        res.allocationsPerFrame = batchedFrames ? double(allocations) / batchedFrames : 0.0;
+        return res;
+    }
+
+    result runPower(int frames)
+    {
+        serialPortHandler handler;
+        handler.setDiagnosticsMode(diagnosticsMode);
+        const QByteArray frame = powerFrame();
+
+        QElapsedTimer timer;
+        const quint64 allocBefore = allocationCount.load();
+        timer.start();
+        for(int i = 0; i < frames; ++i)
+        {
+            handler.recvMsgId(0x02);
+            handler.injectBytes(frame.constData(), frame.size());
+        }
+        const qint64 elapsedNs = timer.nsecsElapsed();
+
+        result res;
+        res.frames = static_cast<quint64>(frames);
+        res.nsPerFrame = double(elapsedNs) / frames;
+        res.megabytesPerSecond = (double(frame.size()) * frames / 1e6) / (elapsedNs / 1e9);
+        res.allocationsPerFrame = double(allocationCount.load() - allocBefore) / frames;
+        return res;
+    }
+
+    struct completion
+    {
+        int earlyCompletions; //plotCompleted before the last byte was fed
+        int completions;
+        quint64 frames;
+    };
+
+    //Feeds stream in the given pieces, then lets the line go quiet so the
+    //handler can confirm the terminator
+    completion runToCompletion(const QByteArray &stream, const QVector<int> &pieces)
+    {
+        serialPortHandler handler;
+        completion res = {0, 0, 0};
+        QObject::connect(&handler, &serialPortHandler::plotCompleted, [&res]() { ++res.completions; });
+        handler.setFrameBatchHandler([&res](const frameBatch &batch) { res.frames += batch.count; });
+        handler.recvMsgId(0x01);
+
+        int pos = 0;
+        for(int piece : pieces)
+        {
+            handler.injectBytes(stream.constData() + pos, piece);
+            pos += piece;
+        }
+        res.earlyCompletions = res.completions;
+        handler.injectBytes(stream.constData() + pos, stream.size() - pos);
+
+        QElapsedTimer quiet;
+        quiet.start();
+        while(res.completions == 0 && quiet.elapsed() < 10 * serialPortHandler::TerminatorQuietMs)
+        {
+            QCoreApplication::processEvents(QEventLoop::AllEvents, serialPortHandler::TerminatorQuietMs);
+        }
+        return res;
+    }
+
+    //The run must end once at the terminator, whatever its alignment, and not
+    //at terminator bytes that happen to sit at a read boundary mid-run
+    bool checkCompletion(QTextStream &out)
+    {
+        const int frames = 1000;
+        const QByteArray aligned = syntheticLiveStream(frames);
+
+        QByteArray dropped = aligned;
+        dropped.remove(6 * (frames / 2) + 1, 1);
+
+        QByteArray lookalike = aligned;
+        const int at = 6 * (frames / 2);
+        lookalike[at] = static_cast<char>(0xff);
+        lookalike[at + 1] = static_cast<char>(0xdd);
+        lookalike[at + 2] = static_cast<char>(0xff);
+
+        struct check
+        {
+            const char *name;
+            completion got;
+            quint64 frames;
+        };
+        const check checks[] = {
+            {"aligned", runToCompletion(aligned, QVector<int>() << 4096), frames},
+            {"one byte dropped", runToCompletion(dropped, QVector<int>() << 4096), frames - 1},
+            {"terminator bytes at a read end", runToCompletion(lookalike, QVector<int>() << at + 3), frames},
+        };
+
+        bool ok = true;
+        for(const check &c : checks)
+        {
+            const bool passed = c.got.earlyCompletions == 0 && c.got.completions == 1 && c.got.frames == c.frames;
+            out << "completion " << c.name << ": " << (passed ? "ok" : "FAILED") << " (" << c.got.completions
+                << " completions, " << c.got.frames << " frames)" << Qt::endl;
+            ok = ok && passed;
+        }
+        return ok;
+    }
+
+    void printRow(QTextStream &out, const QString &name, const result &res)
+    {
+        out << qSetFieldWidth(24) << Qt::left << name << qSetFieldWidth(12) << Qt::right
+            << QString::number(res.nsPerFrame, 'f', 1)
+            << QString::number(res.megabytesPerSecond, 'f', 1)
+            << QString::number(res.allocationsPerFrame, 'f', 3)
+            << QString::number(res.frames)
+            << qSetFieldWidth(0) << Qt::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption framesOption("frames", "Synthetic live frames per run.", "count", "200000");
+    QCommandLineOption repeatOption("repeat", "Runs per burst size.", "count", "3");
+    QCommandLineOption captureOption("capture", "Also replay a .lpcap capture with its recorded read sizes.", "file");
+    parser.addOption(framesOption);
+    parser.addOption(repeatOption);
+    QCommandLineOption verboseOption("verbose", "Measure with per-frame diagnostics enabled.");
+    parser.addOption(captureOption);
+    parser.addOption(verboseOption);
+    parser.process(a);
+
+    if(parser.isSet(verboseOption))
+    {
+        diagnosticsMode = serialPortHandler::DiagnosticsVerbose;
+    }
+
+    qInstallMessageHandler(discardMessages);
+
+    const int frames = parser.value(framesOption).toInt();
+    const int repeats = qMax(1, parser.value(repeatOption).toInt());
+    const int bursts[] = {1, 6, 64, 512, 4096, 65536};
+
+    QTextStream out(stdout);
+    out << qSetFieldWidth(24) << Qt::left << "case" << qSetFieldWidth(12) << Qt::right
+        << "ns/frame" << "MB/s" << "allocs/frame" << "frames" << qSetFieldWidth(0) << Qt::endl;
+
+    const QByteArray synthetic = syntheticLiveStream(frames);
+    for(int burst : bursts)
+    {
+        printRow(out, QString("live synthetic %1 B").arg(burst), runLive(synthetic, burst, repeats));
+    }
+
+    if(parser.isSet(captureOption))
+    {
+        const QVector<captureReader::record> captured = loadCapture(parser.value(captureOption));
+        if(captured.isEmpty())
+        {
+            out << "capture is empty or unreadable" << Qt::endl;
+        }
+        else
+        {
+            printRow(out, "live capture (as read)", runCapture(captured, repeats));
+        }
+    }
+
+    printRow(out, "power frame decode", runPower(qMax(1, frames / 10)));
+
+    return checkCompletion(out) ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+# Micro-benchmark for the serialPortHandler framing and decode path.
+# Build: qmake && make, then run ./parserbench [--capture file.lpcap]
+
+QT       += core serialport
+QT       -= gui
+
+CONFIG += c++11 console release
+CONFIG -= app_bundle
+
+TARGET = parserbench
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../asynclogger.cpp \
+    ../../capturefile.cpp \
+    ../../capturereplay.cpp \
+    ../../eventlog.cpp \
+    ../../logarchive.cpp \
+    ../../logtimestamp.cpp \
+    ../../receivebuffer.cpp \
+    ../../serialporthandler.cpp
+
+HEADERS += \
+    ../../asynclogger.h \
+    ../../capturefile.h \
+    ../../capturereplay.h \
+    ../../eventlog.h \
+    ../../frameparser.h \
+    ../../ingeststats.h \
+    ../../jigprotocol.h \
+    ../../logarchive.h \
+    ../../logtimestamp.h \
+    ../../mpscqueue.h \
+    ../../receivebuffer.h \
+    ../../serialporthandler.h \
+    ../../spscring.h
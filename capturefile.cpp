@@ -0,0 +1,155 @@
+#include "capturefile.h"
+#include <QDateTime>
+#include <QtEndian>
+#include <cstring>
+
+const char captureFormat::Magic[8] = {'L', 'P', 'C', 'A', 'P', 0x01, 0x00, 0x00};
+
+namespace
+{
+    int encodeVarint(quint64 value, uchar *out)
+    {
+        int n = 0;
+        while(value >= 0x80)
+        {
+            out[n++] = static_cast<uchar>(value | 0x80);
+            value >>= 7;
+        }
+        out[n++] = static_cast<uchar>(value);
+        return n;
+    }
+}
+
+captureRecorder::captureRecorder() : lastNs(0)
+{
+}
+
+captureRecorder::~captureRecorder()
+{
+    close();
+}
+
+bool captureRecorder::open(const QString &fileName)
+{
+    close();
+
+    file.setFileName(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    uchar header[captureFormat::HeaderSize];
+    memcpy(header, captureFormat::Magic, sizeof(captureFormat::Magic));
+    qToLittleEndian<quint64>(static_cast<quint64>(QDateTime::currentMSecsSinceEpoch()), header + 8);
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+    clock.start();
+    lastNs = 0;
+    return true;
+}
+
+void captureRecorder::close()
+{
+    if(file.isOpen())
+    {
+        file.flush();
+        file.close();
+    }
+}
+
+void captureRecorder::recordBytes(const char *data, qint64 len)
+{
+    if(len > 0)
+    {
+        writeRecord(captureFormat::RecordBytes, data, len);
+    }
+}
+
+void captureRecorder::recordMsgId(quint8 msgId)
+{
+    writeRecord(captureFormat::RecordMsgId, reinterpret_cast<const char *>(&msgId), 1);
+}
+
+void captureRecorder::writeRecord(quint8 kind, const char *data, qint64 len)
+{
+    if(!file.isOpen())
+    {
+        return;
+    }
+
+    const qint64 now = clock.nsecsElapsed();
+
+    uchar head[1 + 10 + 10];
+    int n = 0;
+    head[n++] = kind;
+    n += encodeVarint(static_cast<quint64>(now - lastNs), head + n);
+    n += encodeVarint(static_cast<quint64>(len), head + n);
+    lastNs = now;
+
+    //QFile buffers internally, so small reads do not turn into one syscall each
+    file.write(reinterpret_cast<const char *>(head), n);
+    file.write(data, len);
+}
+
+bool captureReader::open(const QString &fileName)
+{
+    file.setFileName(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    uchar header[captureFormat::HeaderSize];
+    if(file.read(reinterpret_cast<char *>(header), sizeof(header)) != sizeof(header)
+            || memcmp(header, captureFormat::Magic, sizeof(captureFormat::Magic)) != 0)
+    {
+        file.close();
+        return false;
+    }
+
+    startMs = static_cast<qint64>(qFromLittleEndian<quint64>(header + 8));
+    timestampNs = 0;
+    return true;
+}
+
+bool captureReader::readVarint(quint64 &value)
+{
+    value = 0;
+    for(int shift = 0; shift < 64; shift += 7)
+    {
+        char c;
+        if(!file.getChar(&c))
+        {
+            return false;
+        }
+        value |= static_cast<quint64>(static_cast<uchar>(c) & 0x7f) << shift;
+        if(!(static_cast<uchar>(c) & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool captureReader::next(record &out)
+{
+    char kind;
+    quint64 delta = 0;
+    quint64 len = 0;
+    if(!file.getChar(&kind) || !readVarint(delta) || !readVarint(len) || len > (1u << 30))
+    {
+        return false;
+    }
+
+    out.payload.resize(static_cast<int>(len));
+    if(file.read(out.payload.data(), static_cast<qint64>(len)) != static_cast<qint64>(len))
+    {
+        return false;
+    }
+
+    timestampNs += static_cast<qint64>(delta);
+    out.kind = static_cast<quint8>(kind);
+    out.timestampNs = timestampNs;
+    return true;
+}
@@ -0,0 +1,84 @@
+#ifndef CAPTUREFILE_H
+#define CAPTUREFILE_H
+
+#include <QtGlobal>
+#include <QFile>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+// Raw serial capture format (.lpcap)
+//
+//   header : "LPCAP" 0x01 0x00 0x00, then quint64 LE wall-clock start (ms since epoch)
+//   record : quint8 kind, varint delta ns since previous record, varint length, payload
+//
+// kind RecordBytes carries exactly what one QSerialPort read returned,
+// kind RecordMsgId carries the one-byte msgId that became active, so a replay
+// frames the bytes the same way the live session did. Timestamps come from a
+// monotonic clock and are stored as deltas, which keeps a record header at
+// three or four bytes for typical reads.
+namespace captureFormat
+{
+    enum RecordKind
+    {
+        RecordBytes = 0,
+        RecordMsgId = 1
+    };
+
+    extern const char Magic[8];
+    enum { HeaderSize = 16 };
+}
+
+class captureRecorder
+{
+public:
+    captureRecorder();
+    ~captureRecorder();
+
+    bool open(const QString &fileName);
+    void close();
+    bool isOpen() const { return file.isOpen(); }
+
+    void recordBytes(const char *data, qint64 len);
+    void recordMsgId(quint8 msgId);
+
+    QString errorString() const { return file.errorString(); }
+
+private:
+    void writeRecord(quint8 kind, const char *data, qint64 len);
+
+    QFile file;
+    QElapsedTimer clock;
+    qint64 lastNs;
+};
+
+class captureReader
+{
+public:
+    struct record
+    {
+        quint8 kind;
+        qint64 timestampNs; //since the start of the capture
+        QByteArray payload;
+    };
+
+    bool open(const QString &fileName);
+    void close() { file.close(); }
+    bool atEnd() const { return file.atEnd(); }
+
+    //Wall-clock time the capture was started, ms since epoch
+    qint64 startedMs() const { return startMs; }
+
+    //Returns false at the end of the file or on a truncated record
+    bool next(record &out);
+
+    QString errorString() const { return file.errorString(); }
+
+private:
+    bool readVarint(quint64 &value);
+
+    QFile file;
+    qint64 startMs = 0;
+    qint64 timestampNs = 0;
+};
+
+#endif // CAPTUREFILE_H
@@ -0,0 +1,92 @@
+#include "capturereplay.h"
+#include <QDebug>
+
+namespace
+{
+    //Upper bound of work per event loop pass when replaying as fast as possible
+    const qint64 MaxSliceNs = 5 * 1000 * 1000;
+}
+
+captureReplay::captureReplay(QObject *parent) : QObject(parent)
+{
+    stepTimer.setSingleShot(true);
+    stepTimer.setTimerType(Qt::PreciseTimer);
+    connect(&stepTimer, &QTimer::timeout, this, &captureReplay::step);
+}
+
+bool captureReplay::start(const QString &fileName, double speed)
+{
+    stop();
+
+    if(!reader.open(fileName))
+    {
+        qWarning() << "Cannot open capture" << fileName;
+        return false;
+    }
+
+    playSpeed = qMax(speed, 0.0);
+    hasPending = false;
+    running = true;
+    wallClock.start();
+    stepTimer.start(0);
+    return true;
+}
+
+void captureReplay::stop()
+{
+    stepTimer.stop();
+    reader.close();
+    hasPending = false;
+    running = false;
+}
+
+void captureReplay::step()
+{
+    if(!running)
+    {
+        return;
+    }
+
+    QElapsedTimer slice;
+    slice.start();
+
+    for(;;)
+    {
+        if(!hasPending)
+        {
+            if(!reader.next(pendingRecord))
+            {
+                stop();
+                emit finished();
+                return;
+            }
+            hasPending = true;
+        }
+
+        if(playSpeed > 0.0)
+        {
+            const qint64 dueNs = static_cast<qint64>(pendingRecord.timestampNs / playSpeed);
+            const qint64 waitNs = dueNs - wallClock.nsecsElapsed();
+            if(waitNs > 0)
+            {
+                stepTimer.start(static_cast<int>(qMin<qint64>(waitNs / 1000000, 1000)));
+                return;
+            }
+        }
+        else if(slice.nsecsElapsed() > MaxSliceNs)
+        {
+            stepTimer.start(0);
+            return;
+        }
+
+        hasPending = false;
+        if(pendingRecord.kind == captureFormat::RecordMsgId && pendingRecord.payload.size() == 1)
+        {
+            emit msgIdReplayed(static_cast<quint8>(pendingRecord.payload.at(0)));
+        }
+        else if(pendingRecord.kind == captureFormat::RecordBytes)
+        {
+            emit bytesReplayed(pendingRecord.payload.constData(), pendingRecord.payload.size());
+        }
+    }
+}
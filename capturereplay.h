@@ -0,0 +1,41 @@
+#ifndef CAPTUREREPLAY_H
+#define CAPTUREREPLAY_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include "capturefile.h"
+
+// Plays a .lpcap capture back on the thread it lives on, honouring the
+// recorded read boundaries. speed 1.0 reproduces the original timing, N
+// plays N times faster and 0 feeds records as fast as the consumer takes them
+// (still returning to the event loop between slices so the thread stays live).
+class captureReplay : public QObject
+{
+    Q_OBJECT
+public:
+    explicit captureReplay(QObject *parent = nullptr);
+
+    bool start(const QString &fileName, double speed);
+    void stop();
+    bool isRunning() const { return running; }
+
+signals:
+    void bytesReplayed(const char *data, int len);
+    void msgIdReplayed(quint8 msgId);
+    void finished();
+
+private slots:
+    void step();
+
+private:
+    captureReader reader;
+    captureReader::record pendingRecord;
+    bool hasPending = false;
+    bool running = false;
+    double playSpeed = 1.0;
+    QElapsedTimer wallClock;
+    QTimer stepTimer;
+};
+
+#endif // CAPTUREREPLAY_H
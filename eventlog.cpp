@@ -0,0 +1,109 @@
+#include "eventlog.h"
+#include <QByteArray>
+#include <QtEndian>
+#include <cstring>
+
+const char eventLog::Magic[8] = {'L', 'P', 'E', 'V', 'T', 0x01, 0x00, 0x00};
+
+namespace
+{
+    QString payloadHex(const eventLog::record &in)
+    {
+        return QString::fromLatin1(QByteArray(reinterpret_cast<const char *>(in.payload), in.storedLength()).toHex());
+    }
+}
+
+void eventLog::fill(record &out, quint64 timestampNs, quint16 eventId, quint8 msgId, const void *payload, int len)
+{
+    out.timestampNs = timestampNs;
+    out.eventId = eventId;
+    out.msgId = msgId;
+    out.reserved = 0;
+    out.length = static_cast<quint32>(qMax(len, 0));
+    if(len > 0)
+    {
+        memcpy(out.payload, payload, static_cast<size_t>(out.storedLength()));
+    }
+}
+
+void eventLog::encode(const record &in, QByteArray &out)
+{
+    uchar head[RecordHeaderSize];
+    qToLittleEndian<quint64>(in.timestampNs, head);
+    qToLittleEndian<quint16>(in.eventId, head + 8);
+    head[10] = in.msgId;
+    head[11] = in.reserved;
+    qToLittleEndian<quint32>(in.length, head + 12);
+
+    out.append(reinterpret_cast<const char *>(head), RecordHeaderSize);
+    out.append(reinterpret_cast<const char *>(in.payload), in.storedLength());
+}
+
+QString eventLog::describe(const record &in)
+{
+    switch(in.eventId)
+    {
+    case EventNote:
+        return QString::fromUtf8(reinterpret_cast<const char *>(in.payload), in.storedLength());
+    case EventLiveFrame:
+        return "Start Command 6 bytes received: " + QString::number(in.length);
+    case EventLiveTerminator:
+        return "Start Command received bytes check: " + payloadHex(in);
+    case EventLivePartial:
+        return "Start Command received Chunk Size " + QString::number(in.length);
+    case EventPowerFrame:
+        return "Power Card Data received bytes check: " + payloadHex(in);
+    case EventPowerPartial:
+        return "Required 17 bytes Received bytes: " + QString::number(in.length) + " " + payloadHex(in);
+    default:
+        return QString("Event %1 msgId %2: %3").arg(in.eventId).arg(in.msgId).arg(payloadHex(in));
+    }
+}
+
+bool eventLogReader::open(const QString &fileName)
+{
+    file.setFileName(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+    if(!open(&file))
+    {
+        file.close();
+        return false;
+    }
+    return true;
+}
+
+bool eventLogReader::open(QIODevice *source)
+{
+    uchar header[eventLog::HeaderSize];
+    if(source->read(reinterpret_cast<char *>(header), sizeof(header)) != sizeof(header)
+            || memcmp(header, eventLog::Magic, sizeof(eventLog::Magic)) != 0)
+    {
+        device = nullptr;
+        return false;
+    }
+
+    device = source;
+    startMs = static_cast<qint64>(qFromLittleEndian<quint64>(header + 8));
+    return true;
+}
+
+bool eventLogReader::next(eventLog::record &out)
+{
+    uchar head[eventLog::RecordHeaderSize];
+    if(!device || device->read(reinterpret_cast<char *>(head), sizeof(head)) != sizeof(head))
+    {
+        return false;
+    }
+
+    out.timestampNs = qFromLittleEndian<quint64>(head);
+    out.eventId = qFromLittleEndian<quint16>(head + 8);
+    out.msgId = head[10];
+    out.reserved = head[11];
+    out.length = qFromLittleEndian<quint32>(head + 12);
+
+    const qint64 stored = out.storedLength();
+    return device->read(reinterpret_cast<char *>(out.payload), stored) == stored;
+}
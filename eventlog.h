@@ -0,0 +1,83 @@
+#ifndef EVENTLOG_H
+#define EVENTLOG_H
+
+#include <QtGlobal>
+#include <QFile>
+#include <QString>
+
+// Binary event log (.lpevt), written by asyncLogger next to debug_notes.txt
+//
+//   header : "LPEVT" 0x01 0x00 0x00, then quint64 LE wall-clock time (ms since epoch)
+//            at which the monotonic clock below read zero
+//   record : quint64 LE monotonic ns, quint16 LE event id, quint8 msgId, quint8 reserved,
+//            quint32 LE original payload length, then min(length, MaxPayload) payload bytes
+//
+// Frames and hex dumps are stored as the raw bytes, so logging one is a
+// memcpy into the queue; the text the old notes file held is produced by
+// describe() when the log is read back (tools/logdecode).
+namespace eventLog
+{
+    enum EventId
+    {
+        EventNote = 0,          //free text, UTF-8
+        EventLiveFrame = 1,     //one 6-byte live frame
+        EventLiveTerminator = 2,//ff dd ff
+        EventLivePartial = 3,   //unread bytes left at the end of a live burst
+        EventPowerFrame = 4,    //one 17-byte power frame
+        EventPowerPartial = 5   //unread bytes left at the end of a power burst
+    };
+
+    enum
+    {
+        HeaderSize = 16,
+        RecordHeaderSize = 16,
+        MaxPayload = 44 //keeps a queued record at 64 bytes
+    };
+
+    extern const char Magic[8];
+
+    struct record
+    {
+        quint64 timestampNs;
+        quint16 eventId;
+        quint8 msgId;
+        quint8 reserved;
+        quint32 length; //as logged, the stored bytes are capped at MaxPayload
+        uchar payload[MaxPayload];
+
+        int storedLength() const { return static_cast<int>(qMin<quint32>(length, MaxPayload)); }
+    };
+
+    //Fills a record, payload is truncated to MaxPayload
+    void fill(record &out, quint64 timestampNs, quint16 eventId, quint8 msgId, const void *payload, int len);
+
+    //Appends the on-disk form of a record
+    void encode(const record &in, QByteArray &out);
+
+    //The line the notes file used to hold for this event, without the timestamp
+    QString describe(const record &in);
+}
+
+class eventLogReader
+{
+public:
+    bool open(const QString &fileName);
+    //Reads from an already open device, e.g. a decompressed archive in a QBuffer
+    bool open(QIODevice *source);
+    void close() { file.close(); device = nullptr; }
+
+    //Wall-clock time at monotonic zero, ms since epoch
+    qint64 startedMs() const { return startMs; }
+
+    //Returns false at the end of the file or on a truncated record
+    bool next(eventLog::record &out);
+
+    QString errorString() const { return device ? device->errorString() : file.errorString(); }
+
+private:
+    QFile file;
+    QIODevice *device = nullptr;
+    qint64 startMs = 0;
+};
+
+#endif // EVENTLOG_H
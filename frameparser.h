@@ -0,0 +1,119 @@
+#ifndef FRAMEPARSER_H
+#define FRAMEPARSER_H
+
+#include <QtGlobal>
+#include "jigprotocol.h"
+
+// Streaming parser for one jig message layout (see jigprotocol.h).
+//
+// parse() walks the receive storage in place with a read cursor and never
+// copies. Each whole frame is handed to the sink as a pointer into the
+// caller's bytes, so the sink must use it before the storage is modified.
+// A frame whose header or checksum does not match is skipped one byte at a
+// time until the stream lines up again. For layouts with a terminator (the
+// live stream's ff dd ff), trailing bytes that are it or could begin it are
+// held back at any frame alignment, so a lost or extra byte earlier in the
+// run does not hide it.
+// They are parsed as frame data if more bytes follow; once the caller sees
+// the line go quiet it calls complete() to end the stream, which matches how
+// the jig ends a run. Work per call is constant per byte, whatever the burst
+// size.
+//
+// Sink must provide:
+//   void onFrame(const uchar *frame);         // Layout::Length bytes
+//   void onTerminator(const uchar *term);     // Layout::TerminatorLength bytes
+//   void onChecksumError(const uchar *frame);
+//   void onResync();                          // one byte skipped
+template<typename Layout>
+class frameParser
+{
+public:
+    enum { FrameSize = Layout::Length, TerminatorSize = Layout::TerminatorLength };
+
+    enum State
+    {
+        Streaming, //collecting frames
+        Completed  //terminator seen, everything else is ignored until reset()
+    };
+
+    frameParser() : parseState(Streaming) {}
+
+    void reset() { parseState = Streaming; }
+
+    State state() const { return parseState; }
+
+    // Returns the number of bytes consumed. A trailing partial frame, and
+    // trailing bytes that are or may become the terminator, are left
+    // unconsumed; pass them again (followed by the new bytes) on the next call.
+    template<typename Sink>
+    qint64 parse(const uchar *data, qint64 len, Sink &sink)
+    {
+        if(parseState == Completed)
+            return len;
+
+        const uchar *cursor = data;
+        const uchar *const end = data + len - terminatorTail(data, len);
+
+        while(end - cursor >= FrameSize)
+        {
+            if(!Layout::headerMatches(cursor))
+            {
+                sink.onResync();
+                ++cursor;
+                continue;
+            }
+            if(!jigProtocol::checksum<Layout::Checksum>::verify(cursor, FrameSize))
+            {
+                sink.onChecksumError(cursor);
+                ++cursor;
+                continue;
+            }
+            sink.onFrame(cursor);
+            cursor += FrameSize;
+        }
+
+        return cursor - data;
+    }
+
+    // True if the unconsumed bytes end with the terminator, i.e. the stream
+    // ends here unless more bytes follow.
+    static bool endsWithTerminator(const uchar *data, qint64 len)
+    {
+        return Layout::HasTerminator && len >= TerminatorSize && Layout::isTerminator(data + len - TerminatorSize);
+    }
+
+    // Number of trailing bytes that are the terminator or its beginning
+    static int terminatorTail(const uchar *data, qint64 len)
+    {
+        if(!Layout::HasTerminator)
+            return 0;
+        for(int n = TerminatorSize; n > 0; --n)
+        {
+            if(len >= n && Layout::terminatorStartsWith(data + len - n, n))
+                return n;
+        }
+        return 0;
+    }
+
+    // Call with the unconsumed bytes once no more have arrived for a while.
+    // If they end with the terminator the stream is completed and they are
+    // all consumed (a partial frame before the terminator is discarded);
+    // otherwise nothing happens and 0 is returned.
+    template<typename Sink>
+    qint64 complete(const uchar *data, qint64 len, Sink &sink)
+    {
+        if(parseState == Completed)
+            return len;
+        if(!endsWithTerminator(data, len))
+            return 0;
+
+        sink.onTerminator(data + len - TerminatorSize);
+        parseState = Completed;
+        return len;
+    }
+
+private:
+    State parseState;
+};
+
+#endif // FRAMEPARSER_H
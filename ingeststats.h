@@ -0,0 +1,121 @@
+#ifndef INGESTSTATS_H
+#define INGESTSTATS_H
+
+#include <QtGlobal>
+#include <atomic>
+
+// Plain copy of the ingest counters at one instant, safe to pass between threads.
+struct ingestSnapshot
+{
+    qint64  timestampNs;       //QElapsedTimer clock of the sample
+    quint64 bytesReceived;     //bytes read from the port
+    quint64 bursts;            //readData() passes that read something
+    quint64 validFrames;       //live frames plus power frames that passed the checks
+    quint64 terminatorHits;    //ff dd ff end of run markers
+    quint64 checksumFailures;  //17-byte power frames failing the XOR check of jigProtocol::frameLayout<MsgPower>
+    quint64 resyncs;           //times unread bytes were thrown away to catch up
+    quint64 droppedBytes;      //unread bytes lost to the receive buffer ceiling
+    quint64 droppedFrames;     //decoded frames lost because the live ring was full
+    quint64 partialStalls;     //bursts that ended in the middle of a frame
+    quint64 maxBurstBytes;     //largest single burst
+    quint64 lastParseNs;       //framing/decoding time of the latest burst
+    quint64 totalParseNs;
+    quint64 queueDepth;        //frames waiting in the live ring for the GUI
+};
+
+// Rates between two snapshots of the same handler.
+struct ingestRates
+{
+    double bytesPerSecond;
+    double framesPerSecond;
+    double avgParseNsPerBurst;
+};
+
+inline ingestRates ingestRatesBetween(const ingestSnapshot &before, const ingestSnapshot &after)
+{
+    ingestRates rates = {0.0, 0.0, 0.0};
+    const double seconds = (after.timestampNs - before.timestampNs) / 1e9;
+    if(seconds > 0.0)
+    {
+        rates.bytesPerSecond = (after.bytesReceived - before.bytesReceived) / seconds;
+        rates.framesPerSecond = (after.validFrames - before.validFrames) / seconds;
+    }
+    const quint64 bursts = after.bursts - before.bursts;
+    if(bursts > 0)
+    {
+        rates.avgParseNsPerBurst = double(after.totalParseNs - before.totalParseNs) / bursts;
+    }
+    return rates;
+}
+
+// Always-on counters updated by the acquisition thread and readable from any
+// thread. Writers use relaxed increments, there is a single writer so the cost
+// is an uncontended add per event.
+struct ingestCounters
+{
+    ingestCounters() { reset(); }
+
+    void reset()
+    {
+        bytesReceived.store(0, std::memory_order_relaxed);
+        bursts.store(0, std::memory_order_relaxed);
+        validFrames.store(0, std::memory_order_relaxed);
+        terminatorHits.store(0, std::memory_order_relaxed);
+        checksumFailures.store(0, std::memory_order_relaxed);
+        resyncs.store(0, std::memory_order_relaxed);
+        droppedBytes.store(0, std::memory_order_relaxed);
+        droppedFrames.store(0, std::memory_order_relaxed);
+        partialStalls.store(0, std::memory_order_relaxed);
+        maxBurstBytes.store(0, std::memory_order_relaxed);
+        lastParseNs.store(0, std::memory_order_relaxed);
+        totalParseNs.store(0, std::memory_order_relaxed);
+    }
+
+    static void add(std::atomic<quint64> &counter, quint64 value)
+    {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    static void raiseTo(std::atomic<quint64> &counter, quint64 value)
+    {
+        quint64 current = counter.load(std::memory_order_relaxed);
+        while(value > current && !counter.compare_exchange_weak(current, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    ingestSnapshot snapshot(qint64 timestampNs, quint64 queueDepth) const
+    {
+        ingestSnapshot s;
+        s.timestampNs = timestampNs;
+        s.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+        s.bursts = bursts.load(std::memory_order_relaxed);
+        s.validFrames = validFrames.load(std::memory_order_relaxed);
+        s.terminatorHits = terminatorHits.load(std::memory_order_relaxed);
+        s.checksumFailures = checksumFailures.load(std::memory_order_relaxed);
+        s.resyncs = resyncs.load(std::memory_order_relaxed);
+        s.droppedBytes = droppedBytes.load(std::memory_order_relaxed);
+        s.droppedFrames = droppedFrames.load(std::memory_order_relaxed);
+        s.partialStalls = partialStalls.load(std::memory_order_relaxed);
+        s.maxBurstBytes = maxBurstBytes.load(std::memory_order_relaxed);
+        s.lastParseNs = lastParseNs.load(std::memory_order_relaxed);
+        s.totalParseNs = totalParseNs.load(std::memory_order_relaxed);
+        s.queueDepth = queueDepth;
+        return s;
+    }
+
+    std::atomic<quint64> bytesReceived;
+    std::atomic<quint64> bursts;
+    std::atomic<quint64> validFrames;
+    std::atomic<quint64> terminatorHits;
+    std::atomic<quint64> checksumFailures;
+    std::atomic<quint64> resyncs;
+    std::atomic<quint64> droppedBytes;
+    std::atomic<quint64> droppedFrames;
+    std::atomic<quint64> partialStalls;
+    std::atomic<quint64> maxBurstBytes;
+    std::atomic<quint64> lastParseNs;
+    std::atomic<quint64> totalParseNs;
+};
+
+#endif // INGESTSTATS_H
@@ -0,0 +1,146 @@
+#ifndef JIGPROTOCOL_H
+#define JIGPROTOCOL_H
+
+#include <QtGlobal>
+
+// Frame layouts of the HighGTestJig replies, one specialization per msgId.
+//
+// Every layout describes its fixed length, how a frame starts, which
+// checksum guards it, whether a terminator closes the stream, and an inline
+// decode kernel. frameParser<Layout> and serialPortHandler's dispatch table
+// are instantiated per layout, so all of this is resolved at compile time and
+// the per-byte loop never branches on which message it is reading.
+//
+// Adding a message: specialize frameLayout for the new id, add a
+// serialPortHandler::frameSink for it and one line to burstTable().
+namespace jigProtocol
+{
+    enum MsgId
+    {
+        MsgLive  = 0x01, //ff 0a ff -> 6-byte frames ... ff dd ff
+        MsgPower = 0x02  //47 01 chk -> 54 01 <7 x 16-bit> chk
+    };
+
+    enum ChecksumKind
+    {
+        NoChecksum,
+        XorChecksum //XOR of every byte but the last equals the last byte
+    };
+
+    inline quint16 beWord(const uchar *p)
+    {
+        return static_cast<quint16>((p[0] << 8) | p[1]);
+    }
+
+    template<int Kind>
+    struct checksum;
+
+    template<>
+    struct checksum<NoChecksum>
+    {
+        static bool verify(const uchar *, int) { return true; }
+    };
+
+    template<>
+    struct checksum<XorChecksum>
+    {
+        static bool verify(const uchar *frame, int length)
+        {
+            quint8 sum = 0;
+            for(int i = 0; i < length - 1; ++i)
+            {
+                sum ^= frame[i];
+            }
+            return sum == frame[length - 1];
+        }
+    };
+
+    template<int MsgIdValue>
+    struct frameLayout;
+
+    // One decoded 6-byte live frame: three big-endian 16-bit ADC words.
+    struct liveFrame
+    {
+        quint16 word[3];
+    };
+
+    template<>
+    struct frameLayout<MsgLive>
+    {
+        typedef liveFrame decoded;
+
+        enum
+        {
+            Length = 6,
+            Checksum = NoChecksum,
+            HasTerminator = 1,
+            TerminatorLength = 3
+        };
+
+        static bool headerMatches(const uchar *) { return true; }
+
+        //True if the count bytes at p are the first count bytes of ff dd ff
+        static bool terminatorStartsWith(const uchar *p, int count)
+        {
+            static const uchar terminator[TerminatorLength] = {0xff, 0xdd, 0xff};
+            for(int i = 0; i < count; ++i)
+            {
+                if(p[i] != terminator[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool isTerminator(const uchar *p) { return terminatorStartsWith(p, TerminatorLength); }
+
+        static void decode(const uchar *frame, liveFrame &out)
+        {
+            out.word[0] = beWord(frame);
+            out.word[1] = beWord(frame + 2);
+            out.word[2] = beWord(frame + 4);
+        }
+    };
+
+    // Power card rails in volts, in wire order.
+    struct powerReading
+    {
+        enum { Rails = 7 };
+        float volts[Rails]; //+28V, +15V, -15V, ext 10V, +5V, -5V, +3.3V
+    };
+
+    template<>
+    struct frameLayout<MsgPower>
+    {
+        typedef powerReading decoded;
+
+        enum
+        {
+            Length = 17,
+            Checksum = XorChecksum,
+            HasTerminator = 0,
+            TerminatorLength = 0
+        };
+
+        static bool headerMatches(const uchar *p) { return p[0] == 0x54 && p[1] == 0x01; }
+
+        static bool terminatorStartsWith(const uchar *, int) { return false; }
+        static bool isTerminator(const uchar *) { return false; }
+
+        static void decode(const uchar *frame, powerReading &out)
+        {
+            //12-bit ADC over +-10.24 V, the first four rails sit behind a 1:3 divider
+            const uchar *raw = frame + 2;
+            for(int i = 0; i < powerReading::Rails; ++i)
+            {
+                const float v = (beWord(raw + 2 * i) * 20.48f) / 4095.0f - 10.24f;
+                out.volts[i] = i < 4 ? v * 3 : v;
+            }
+        }
+    };
+}
+
+using jigProtocol::liveFrame;
+
+#endif // JIGPROTOCOL_H
@@ -0,0 +1,159 @@
+#include "logarchive.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+#include <cstring>
+
+const char logArchive::Magic[8] = {'L', 'P', 'L', 'O', 'G', 'Z', 0x01, 0x00};
+const char logArchive::Suffix[] = ".qz";
+
+namespace
+{
+    //"debug_notes.*.txt" for debug_notes.txt
+    QString segmentPattern(const QFileInfo &live)
+    {
+        return live.completeBaseName() + ".*." + live.suffix();
+    }
+}
+
+QString logArchive::segmentName(const QString &liveFile, const QDateTime &when)
+{
+    const QFileInfo live(liveFile);
+    const QString stem = live.path() + "/" + live.completeBaseName() + "." + when.toString("yyyyMMdd-HHmmss-zzz");
+
+    QString name = stem + "." + live.suffix();
+    for(int n = 1; QFile::exists(name) || QFile::exists(name + Suffix); ++n)
+    {
+        name = stem + "-" + QString::number(n) + "." + live.suffix();
+    }
+    return name;
+}
+
+QStringList logArchive::pendingSegments(const QString &liveFile)
+{
+    const QFileInfo live(liveFile);
+    const QDir dir(live.path());
+
+    QStringList filters;
+    filters << segmentPattern(live);
+
+    QStringList segments;
+    for(const QString &name : dir.entryList(filters, QDir::Files, QDir::Name))
+    {
+        segments << dir.absoluteFilePath(name);
+    }
+    return segments;
+}
+
+bool logArchive::compress(const QString &segment)
+{
+    QFile in(segment);
+    if(!in.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    const QString archive = segment + Suffix;
+    QFile out(archive + ".part");
+    if(!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    bool ok = out.write(Magic, sizeof(Magic)) == sizeof(Magic);
+    while(ok && !in.atEnd())
+    {
+        const QByteArray chunk = in.read(ChunkBytes);
+        if(chunk.isEmpty())
+        {
+            break;
+        }
+
+        const QByteArray packed = qCompress(chunk);
+        uchar size[4];
+        qToLittleEndian<quint32>(static_cast<quint32>(packed.size()), size);
+        ok = out.write(reinterpret_cast<const char *>(size), sizeof(size)) == sizeof(size)
+                && out.write(packed) == packed.size();
+    }
+    ok = ok && out.flush();
+    out.close();
+    in.close();
+
+    //The segment is only removed once its archive is complete
+    if(!ok)
+    {
+        out.remove();
+        return false;
+    }
+    QFile::remove(archive);
+    if(!out.rename(archive))
+    {
+        return false;
+    }
+    return QFile::remove(segment);
+}
+
+bool logArchive::decompress(const QString &archive, QIODevice *out)
+{
+    QFile in(archive);
+    if(!in.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    char magic[sizeof(Magic)];
+    if(in.read(magic, sizeof(magic)) != sizeof(magic) || memcmp(magic, Magic, sizeof(Magic)) != 0)
+    {
+        return false;
+    }
+
+    while(!in.atEnd())
+    {
+        uchar size[4];
+        if(in.read(reinterpret_cast<char *>(size), sizeof(size)) != sizeof(size))
+        {
+            return false;
+        }
+
+        const qint64 packedSize = qFromLittleEndian<quint32>(size);
+        const QByteArray packed = in.read(packedSize);
+        if(packed.size() != packedSize)
+        {
+            return false;
+        }
+
+        const QByteArray chunk = qUncompress(packed);
+        if(chunk.isEmpty() || out->write(chunk) != chunk.size())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void logArchive::prune(const QString &liveFile, qint64 maxBytes)
+{
+    const QFileInfo live(liveFile);
+    const QDir dir(live.path());
+    QStringList filters;
+    filters << segmentPattern(live) + Suffix;
+    const QStringList archives = dir.entryList(filters, QDir::Files, QDir::Name);
+
+    qint64 total = 0;
+    for(const QString &name : archives)
+    {
+        total += QFileInfo(dir.absoluteFilePath(name)).size();
+    }
+
+    //Oldest first, always keeping the newest archive
+    for(int i = 0; i < archives.size() - 1 && total > maxBytes; ++i)
+    {
+        const QString path = dir.absoluteFilePath(archives[i]);
+        const qint64 size = QFileInfo(path).size();
+        if(QFile::remove(path))
+        {
+            total -= size;
+        }
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef LOGARCHIVE_H
+#define LOGARCHIVE_H
+
+#include <QtGlobal>
+#include <QString>
+#include <QStringList>
+#include <QDateTime>
+
+class QIODevice;
+
+// Closed log segments and their compressed form (.qz)
+//
+//   live file     : debug_notes.txt
+//   closed segment: debug_notes.20261017-143000-250.txt   (renamed, not copied)
+//   archive       : debug_notes.20261017-143000-250.txt.qz
+//
+//   .qz layout    : "LPLOGZ" 0x01 0x00, then chunks of quint32 LE size + qCompress()
+//                   of at most ChunkBytes of the segment
+//
+// Chunking keeps memory bounded for large segments and lets a reader stream
+// the archive back. Segment names sort in time order, which prune() relies on.
+namespace logArchive
+{
+    enum { ChunkBytes = 1 << 20 };
+
+    extern const char Magic[8];
+    extern const char Suffix[]; //".qz"
+
+    //A free name for closing liveFile at the given time
+    QString segmentName(const QString &liveFile, const QDateTime &when);
+
+    //Closed segments of liveFile not compressed yet, oldest first
+    QStringList pendingSegments(const QString &liveFile);
+
+    //Compresses a closed segment into segment + Suffix and removes the segment
+    bool compress(const QString &segment);
+
+    //Writes the original bytes of an archive to out
+    bool decompress(const QString &archive, QIODevice *out);
+
+    //Deletes the oldest archives of liveFile until they fit in maxBytes
+    void prune(const QString &liveFile, qint64 maxBytes);
+}
+
+#endif // LOGARCHIVE_H
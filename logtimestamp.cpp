@@ -0,0 +1,35 @@
+#include "logtimestamp.h"
+#include <QDateTime>
+#include <cstring>
+
+void logClock::start()
+{
+    //Read back to back so the anchor and monotonic zero describe the same instant
+    timer.start();
+    anchor = QDateTime::currentMSecsSinceEpoch();
+}
+
+void timestampFormatter::format(qint64 wallMs, char *out)
+{
+    qint64 offset = wallMs - minuteStartMs;
+    if(!cached || offset < 0 || offset >= 60000)
+    {
+        const QDateTime when = QDateTime::fromMSecsSinceEpoch(wallMs);
+        const QTime time = when.time();
+        offset = time.second() * 1000 + time.msec();
+        minuteStartMs = wallMs - offset;
+        memcpy(prefix, when.toString("yyyy-MM-dd HH:mm:").toLatin1().constData(), PrefixLength);
+        cached = true;
+    }
+
+    const int seconds = static_cast<int>(offset / 1000);
+    const int millis = static_cast<int>(offset % 1000);
+
+    memcpy(out, prefix, PrefixLength);
+    out[17] = static_cast<char>('0' + seconds / 10);
+    out[18] = static_cast<char>('0' + seconds % 10);
+    out[19] = '.';
+    out[20] = static_cast<char>('0' + millis / 100);
+    out[21] = static_cast<char>('0' + millis / 10 % 10);
+    out[22] = static_cast<char>('0' + millis % 10);
+}
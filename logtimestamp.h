@@ -0,0 +1,50 @@
+#ifndef LOGTIMESTAMP_H
+#define LOGTIMESTAMP_H
+
+#include <QtGlobal>
+#include <QElapsedTimer>
+
+// Wall-clock time for log records from the monotonic clock.
+//
+// The wall time is read once in start(); after that now*() only read the
+// monotonic clock, so stamps never go backwards when the system clock is
+// adjusted and cost no time zone work. Drift against the system clock is
+// reset by the next start() (every asyncLogger::open()).
+class logClock
+{
+public:
+    void start();
+    bool isValid() const { return timer.isValid(); }
+
+    //Wall-clock time at monotonic zero, ms since epoch
+    qint64 anchorMs() const { return anchor; }
+
+    qint64 nowNs() const { return timer.nsecsElapsed(); }
+    qint64 nowMs() const { return anchor + timer.elapsed(); }
+
+private:
+    QElapsedTimer timer;
+    qint64 anchor = 0;
+};
+
+// Renders "yyyy-MM-dd HH:mm:ss.zzz" in local time.
+//
+// QDateTime is only asked for the "yyyy-MM-dd HH:mm:" prefix once per minute,
+// the seconds and milliseconds are written from the offset into that minute.
+// Local time offsets and DST changes fall on minute boundaries, so the cached
+// prefix stays right for the whole minute. Not thread-safe, one per writer.
+class timestampFormatter
+{
+public:
+    enum { Length = 23, PrefixLength = 17 };
+
+    //Writes Length characters to out, no terminator
+    void format(qint64 wallMs, char *out);
+
+private:
+    qint64 minuteStartMs = 0;
+    bool cached = false;
+    char prefix[PrefixLength];
+};
+
+#endif // LOGTIMESTAMP_H
@@ -1,11 +1,53 @@
 #include "mainwindow.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
 
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption portOption("port", "Open this serial port (name or device path) at startup.", "port");
+    QCommandLineOption recordOption("record", "Record every serial read to a raw capture file.", "file");
+    QCommandLineOption replayOption("replay", "Replay a raw capture file instead of reading a port.", "file");
+    QCommandLineOption speedOption("speed", "Replay speed factor, 0 plays as fast as possible.", "factor", "1");
+    QCommandLineOption verboseOption("verbose", "Log every serial burst and frame instead of a summary per second (slow).");
+    QCommandLineOption windowOption("window", "Follow the newest samples instead of showing the whole run, 0 = whole run.", "samples", "0");
+    parser.addOption(portOption);
+    parser.addOption(verboseOption);
+    parser.addOption(recordOption);
+    parser.addOption(replayOption);
+    parser.addOption(speedOption);
+    QCommandLineOption fpsOption("fps", "Live plot frames per second, however fast data arrives.", "rate", "60");
+    QCommandLineOption vsyncOption("vsync", "Pace live plot frames by the display refresh instead of a timer.");
+    parser.addOption(windowOption);
+    parser.addOption(fpsOption);
+    QCommandLineOption renderThreadOption("render-thread", "Rasterize the live graph on a worker thread instead of the GUI thread.");
+    parser.addOption(vsyncOption);
+    parser.addOption(renderThreadOption);
+    parser.process(a);
+
     MainWindow w;
     w.show();
+
+    w.setVerboseDiagnostics(parser.isSet(verboseOption));
+    w.setFollowWindow(parser.value(windowOption).toInt());
+    w.setPlotPacing(parser.value(fpsOption).toDouble(), parser.isSet(vsyncOption));
+    w.setThreadedPlotRendering(parser.isSet(renderThreadOption));
+    if(parser.isSet(portOption))
+    {
+        w.attachPort(parser.value(portOption));
+    }
+    if(parser.isSet(recordOption))
+    {
+        w.startCapture(parser.value(recordOption));
+    }
+    if(parser.isSet(replayOption))
+    {
+        w.startReplay(parser.value(replayOption), parser.value(speedOption).toDouble());
+    }
+
     return a.exec();
 }
@@ -2,8 +2,7 @@
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
 
-QFile MainWindow::logFile;
-QTextStream MainWindow::logStream;
+asyncLogger *MainWindow::logger = nullptr;
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -13,7 +12,12 @@ MainWindow::MainWindow(QWidget *parent)
 
     stopFlag = true;
 
-    serialObj =   new serialPortHandler(this);
+    //serialPortHandler lives on its own thread, all calls into it go through queued signals
+    acqThread = new QThread(this);
+    serialObj =   new serialPortHandler;
+    serialObj->moveToThread(acqThread);
+    liveScratch.resize(serialPortHandler::MaxBatchFrames);
+    connect(acqThread,&QThread::finished,serialObj,&QObject::deleteLater);
 
     connect(ui->pushButton_clear,&QPushButton::clicked,ui->textEdit_rawBytes,&QTextEdit::clear);
 
@@ -24,16 +28,23 @@ MainWindow::MainWindow(QWidget *parent)
     connect(ui->comboBox_ports,SIGNAL(activated(const QString &)),this,SLOT(onPortSelected(const QString &)));
 
     connect(this,&MainWindow::sendMsgId,serialObj,&serialPortHandler::recvMsgId);
+    connect(this,&MainWindow::openPort,serialObj,&serialPortHandler::setPORTNAME);
+    connect(this,&MainWindow::sendCommand,serialObj,&serialPortHandler::writeData);
+    connect(this,&MainWindow::diagnosticsModeRequested,serialObj,&serialPortHandler::setDiagnosticsMode);
+    connect(this,&MainWindow::captureRequested,serialObj,&serialPortHandler::startCapture);
+    connect(this,&MainWindow::replayRequested,serialObj,&serialPortHandler::startReplay);
+    connect(serialObj,&serialPortHandler::replayFinished,this,[](){ writeToNotes("Replay finished"); });
 
 
-    //writeToNotes from serial class
-    connect(serialObj,&serialPortHandler::executeWriteToNotes,this,&MainWindow::writeToNotes);
+    //writeToNotes from serial class, called directly on the acquisition thread since it only queues the line
+    connect(serialObj,&serialPortHandler::executeWriteToNotes,&MainWindow::writeToNotes);
 
     //debugging signals
     connect(serialObj,&serialPortHandler::portOpening,this,&MainWindow::portStatus);
 
-    //reset previous notes #Notes things : Logging file
+    //start new notes, the previous run's are archived #Notes things : Logging file
     resetLogFile();
+    serialObj->setEventLogger(logger);
     writeToNotes("*****  Application Started  *****");
     //#################################################
 
@@ -48,65 +59,74 @@ MainWindow::MainWindow(QWidget *parent)
     //************************************************************##############
 
     //Plotting signals
-    connect(serialObj,&serialPortHandler::plotLiveData,this,&MainWindow::recvLivePlotData);
+    connect(serialObj,&serialPortHandler::liveDataAvailable,this,&MainWindow::recvLivePlotData);
+    connect(serialObj,&serialPortHandler::plotCompleted,this,&MainWindow::onPlotCompleted);
     //power command
     connect(serialObj,&serialPortHandler::sendPowerData,this,&MainWindow::receivePowerData);
 
     initializePlot();
 
+    //Live plot frames are paced by the scheduler, not by the arrival of data
+    liveReplot = new replotScheduler(ui->customPlot_chLive1, this);
+    connect(liveReplot, &replotScheduler::frameDue, this, &MainWindow::renderLiveFrame);
+
+    //Ingest telemetry, sampled once a second
+    lastStats = serialObj->statistics();
+    statsTimer = new QTimer(this);
+    connect(statsTimer, &QTimer::timeout, this, &MainWindow::updateIngestStatus);
+    statsTimer->start(1000);
+
+    acqThread->start();
 }
 
 MainWindow::~MainWindow()
 {
     writeToNotes("****** Application Closed ******");
+
+    //serialObj is deleted on its own thread once the event loop has finished
+    acqThread->quit();
+    acqThread->wait();
+
     delete ui;
-    delete serialObj;
     delete responseTimer;
     closeLogFile();
 }
 
 void MainWindow::initializeLogFile() {
-    if (!logFile.isOpen()) {
-        logFile.setFileName("debug_notes.txt");
-        if (!logFile.open(QIODevice::Append | QIODevice::Text)) {
-            qCritical() << "Failed to open log file.";
-        } else {
-            logStream.setDevice(&logFile);
-        }
+    if (!logger) {
+        logger = new asyncLogger;
+    }
+    if (!logger->isOpen()) {
+        logger->open("debug_notes.txt", "debug_events.lpevt");
     }
 }
 
 void MainWindow::resetLogFile() {
-    // Close the log file if it is open
-    if (logFile.isOpen()) {
-        logStream.flush();
-        logFile.close();
+    // Drain and close the log file if it is open
+    if (logger) {
+        logger->shutdown();
     }
 
-    // Check if the file exists and delete it
-    QFile::remove("debug_notes.txt");
-
-    // Reinitialize the log file
+    // Reinitialize the log file, the previous contents are rotated into a compressed archive
     initializeLogFile();
 }
 
 
 void MainWindow::writeToNotes(const QString &data) {
-    if (!logFile.isOpen()) {
+    if (!logger || !logger->isOpen()) {
         qCritical() << "Log file is not open.";
         return;
     }
 
-    // Add a timestamp for each entry
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss.zzz");
-    logStream << "[" << timestamp << "] " << data << Qt::endl;
-    logStream.flush(); // Ensure immediate write to disk
+    // Timestamped here, formatted and written by the logger thread
+    logger->log(data);
 }
 
 void MainWindow::closeLogFile() {
-    if (logFile.isOpen()) {
-        logStream.flush();
-        logFile.close();
+    if (logger) {
+        logger->shutdown();
+        delete logger;
+        logger = nullptr;
     }
 }
 
@@ -135,7 +155,7 @@ void MainWindow::refreshPorts()
 
 void MainWindow::onPortSelected(const QString &portName)
 {
-    serialObj->setPORTNAME(portName);
+    emit openPort(portName);
 }
 
 void MainWindow::handleTimeout()
@@ -173,11 +193,19 @@ QString MainWindow::hexBytes(QByteArray &cmd)
 void MainWindow::initializePlot()
 {
     // Clear existing data from the plot
-    if (ui->customPlot_chLive1->graphCount() > 0) {
-        ui->customPlot_chLive1->graph(0)->data()->clear();
+    if (liveGraph) {
+        liveGraph->data()->clear();
+        liveCodes.clear();
     } else {
-        // Create a single graph if it doesn't already exist
-        ui->customPlot_chLive1->addGraph();
+        // Create the live graph if it doesn't already exist, the plot owns it
+        liveGraph = new QCPUniformGraph(ui->customPlot_chLive1->xAxis, ui->customPlot_chLive1->yAxis);
+        liveGraph->data()->setKeySampling(0, 1); // key of each value is its sample number
+        // Keep the 16-bit ADC codes (2 bytes per sample), scaled like plotLiveFrames() when drawn
+        liveGraph->data()->setStorageFormat(QCPUniformDataContainer::sfUInt16);
+        liveGraph->data()->setValueScale(2.5, -1.5259 / 10000.0);
+        // Own buffered layer, frames with unchanged axes redraw only the graph
+        ui->customPlot_chLive1->setStreamingPlottable(liveGraph);
+        setFollowWindow(followWindow); // size the graph's ring if a window was set first
     }
 
     // Set axes labels (only needs to be done once)
@@ -185,9 +213,10 @@ void MainWindow::initializePlot()
     ui->customPlot_chLive1->yAxis->setLabel("Scaled Value");
 
     // Customize graph appearance (optional)
-    ui->customPlot_chLive1->graph(0)->setPen(QPen(Qt::blue)); // Set line color
-    ui->customPlot_chLive1->graph(0)->setLineStyle(QCPGraph::lsLine); // Line style
-    ui->customPlot_chLive1->graph(0)->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssNone)); // No scatter points
+    liveGraph->setPen(QPen(Qt::blue)); // Set line color
+    liveGraph->setLineStyle(QCPUniformGraph::lsLine); // Line style
+    liveGraph->setScatterStyle(QCPScatterStyle(QCPScatterStyle::ssNone)); // No scatter points
+    liveGraph->data()->setLevelOfDetail(true); // min/max pyramid for long runs
 
     // Enable zooming and panning
     ui->customPlot_chLive1->setInteraction(QCP::iRangeZoom, true);       // Enable zooming
@@ -200,6 +229,36 @@ void MainWindow::initializePlot()
 }
 
 
+void MainWindow::attachPort(const QString &portName)
+{
+    //ptys are not enumerated by QSerialPortInfo, so list the name before selecting it
+    if (ui->comboBox_ports->findText(portName) < 0) {
+        ui->comboBox_ports->addItem(portName);
+    }
+    ui->comboBox_ports->setCurrentText(portName);
+    emit openPort(portName);
+}
+
+void MainWindow::setVerboseDiagnostics(bool verbose)
+{
+    emit diagnosticsModeRequested(verbose ? serialPortHandler::DiagnosticsVerbose : serialPortHandler::DiagnosticsSummary);
+}
+
+void MainWindow::startCapture(const QString &fileName)
+{
+    emit captureRequested(fileName);
+}
+
+void MainWindow::startReplay(const QString &fileName, double speed)
+{
+    //Same plot reset as a real start command
+    initializePlot();
+    resetLiveRun();
+
+    emit replayRequested(fileName, speed);
+}
+
+
 void MainWindow::portStatus(const QString &data)
 {
     if(data.startsWith("Serial object is not initialized/port not selected"))
@@ -230,9 +289,7 @@ void MainWindow::on_pushButton_start_clicked()
     }
 
     initializePlot();
-    sampleNumber = 0;
-    allXValues.clear();
-    allYValues.clear();
+    resetLiveRun();
 
     // Start the timeout timer
     responseTimer->start(4000); // 4 Sec timer
@@ -249,56 +306,129 @@ void MainWindow::on_pushButton_start_clicked()
 
 
     emit sendMsgId(0x01);
-    serialObj->writeData(command);
+    emit sendCommand(command);
 }
 
-void MainWindow::recvLivePlotData(QByteArray &recvData)
+void MainWindow::recvLivePlotData()
 {
-    // Check if recvData has the correct size
-    if (recvData.size() != 6) {
-        qWarning() << "Invalid data size, expected 6 bytes, got: " << recvData.size();
+    //Re-arm before draining so frames pushed while we work raise a new notification
+    serialObj->rearmLiveNotify();
+
+    int received = 0;
+    size_t count = 0;
+    while ((count = serialObj->liveRing().pop(liveScratch.data(), liveScratch.size())) > 0) {
+        plotLiveFrames(liveScratch.data(), static_cast<int>(count));
+        received += static_cast<int>(count);
+    }
+
+    if (received == 0) {
         return;
     }
 
-    QVector<double> xValues; // Temporary X-axis values (sample numbers)
-    QVector<double> yValues; // Temporary Y-axis values (scaled values)
+    // Only mark the plot dirty, the scheduler renders at most one frame per interval
+    liveReplot->requestReplot();
+}
 
-    // Process recvData to extract 6 uint16 values in MSB order
-    for (int i = 0; i < recvData.size()-4; i += 2) {
-        // Extract MSB and LSB from the QByteArray
-        uint8_t msb = static_cast<uint8_t>(recvData.at(i));
-        uint8_t lsb = static_cast<uint8_t>(recvData.at(i + 1));
+void MainWindow::renderLiveFrame()
+{
+    // Append only the new samples, the graph keeps what it already has
+    appendNewSamplesToGraph();
+
+    // Adjust the x and y axis ranges dynamically, y only moves when the data leaves it or shrinks well inside
+    bool rescaled = false;
+    if (followWindow > 0) {
+        ui->customPlot_chLive1->xAxis->setRange(qMax(0, sampleNumber - followWindow), sampleNumber);
+        rescaled = yAutoscale.update(liveWindow.min(), liveWindow.max());
+    } else {
+        // Grow the x range in steps with headroom, frames in between leave the axes alone
+        const QCPRange xRange = ui->customPlot_chLive1->xAxis->range();
+        if (sampleNumber > xRange.upper || xRange.upper > 2.0 * sampleNumber + 200 || xRange.lower != 0) {
+            ui->customPlot_chLive1->xAxis->setRange(0, sampleNumber + sampleNumber / 4 + 100);
+        }
+        rescaled = yAutoscale.update(liveExtremes.min(), liveExtremes.max());
+    }
+    if (rescaled) {
+        ui->customPlot_chLive1->yAxis->setRange(yAutoscale.lower(), yAutoscale.upper());
+    }
+
+    // The scheduler replots after this returns, once for everything drained since the last frame;
+    // the count goes into the once a second status line instead of a log line per frame
+    ++plotFramesSinceStatus;
+}
 
-        // Combine MSB and LSB into a uint16 value
-        uint16_t value = (msb << 8) | lsb;
+void MainWindow::setPlotPacing(double framesPerSecond, bool vsync)
+{
+    liveReplot->setTargetRate(framesPerSecond);
+    liveReplot->setPacing(vsync ? replotScheduler::vsyncPacing : replotScheduler::timerPacing);
+}
+
+void MainWindow::setThreadedPlotRendering(bool enabled)
+{
+    ui->customPlot_chLive1->setPlottingHint(QCP::phThreadedStreaming, enabled);
+}
+
+void MainWindow::plotLiveFrames(const liveFrame *frames, int count)
+{
+    for (int f = 0; f < count; ++f) {
+        // Only the first word of each frame is plotted
+        uint16_t value = frames[f].word[0];
 
         // Scale the value using the formula
         double scaledValue = 2.5 - ((value * 1.5259) / 10000.0);
 
-        // Populate x and y values
-        xValues.append(sampleNumber++); // Increment sample number for each point
-        yValues.append(scaledValue);
+        // The scaled value only feeds the autoscaling, the graph takes the raw code
+        if (followWindow > 0) {
+            liveWindow.push(sampleNumber, scaledValue);
+        }
+        liveExtremes.push(scaledValue);
+        liveCodes.push_back(value);
+        ++sampleNumber; // the graph's key of this point
     }
+}
 
-    // Append the current chunk of data to the accumulated data
-    allXValues.append(xValues);
-    allYValues.append(yValues);
+void MainWindow::resetLiveRun()
+{
+    sampleNumber = 0;
+    liveCodes.clear();
+    liveWindow.clear();
+    liveExtremes.clear();
+    yAutoscale.reset();
+}
 
-    // Update the existing graph with the accumulated data
-    ui->customPlot_chLive1->graph(0)->setData(allXValues, allYValues);
+void MainWindow::setFollowWindow(int samples)
+{
+    followWindow = qMax(0, samples);
+    liveWindow.setWindow(followWindow);
+    yAutoscale.reset();
+    if (liveGraph) {
+        // Keep the window plus the samples just outside its edges, so the line enters the axis rect
+        liveGraph->data()->setCapacity(followWindow > 0 ? followWindow + 2 : 0);
+    }
+}
 
-    // Adjust the x and y axis ranges dynamically
-    ui->customPlot_chLive1->xAxis->setRange(0, sampleNumber); // Use the last sample number
-    ui->customPlot_chLive1->yAxis->setRange(*std::min_element(allYValues.begin(), allYValues.end()),
-                                            *std::max_element(allYValues.begin(), allYValues.end()));
+void MainWindow::appendNewSamplesToGraph()
+{
+    // Keys are the sample numbers, so only the ADC codes are copied, as they are
+    if (!liveCodes.empty()) {
+        liveGraph->data()->addRaw(liveCodes.data(), static_cast<int>(liveCodes.size()));
+    }
 
-    // Enable zooming and panning
-    ui->customPlot_chLive1->setInteraction(QCP::iRangeZoom, true);       // Enable zooming
-    ui->customPlot_chLive1->setInteraction(QCP::iRangeDrag, true);       // Enable panning
+    // The graph holds everything that is drawn, the codes are only buffered between frames
+    liveCodes.clear();
+}
 
-    // Repaint the plot
-    ui->customPlot_chLive1->replot();
-    qInfo() << "Live plot updated with 3 points.";
+void MainWindow::onPlotCompleted()
+{
+    // Show the tail of the run without waiting for the next frame
+    liveReplot->flush();
+
+    QMessageBox *msgBox = new QMessageBox(this);
+    msgBox->setWindowTitle("Completed");
+    msgBox->setText("Plot Completed Successfully");
+    msgBox->setStandardButtons(QMessageBox::Ok);
+    msgBox->setAttribute(Qt::WA_DeleteOnClose); // Automatically delete when closed
+    msgBox->setModal(false); // Set to non-modal
+    msgBox->show();
 }
 
 
@@ -325,7 +455,7 @@ void MainWindow::on_pushButton_getPower_clicked()
 
 
     emit sendMsgId(0x02);
-    serialObj->writeData(command);
+    emit sendCommand(command);
 }
 
 void MainWindow::receivePowerData(QVector<float> recvPowerData)
@@ -399,7 +529,7 @@ void MainWindow::receivePowerData(QVector<float> recvPowerData)
 
 
         emit sendMsgId(0x02);
-        serialObj->writeData(command);
+        emit sendCommand(command);
     }
 }
 
@@ -407,3 +537,22 @@ void MainWindow::on_pushButton_getPowerStop_clicked()
 {
     stopFlag = true;
 }
+
+void MainWindow::updateIngestStatus()
+{
+    const ingestSnapshot now = serialObj->statistics();
+    const ingestRates rates = ingestRatesBetween(lastStats, now);
+    lastStats = now;
+
+    ui->statusbar->showMessage(QString("%1 kB/s  %2 frames/s  queue %3  chk fail %4  resync %5  stalls %6  max burst %7 B  parse %8 us  plot %9 fps")
+                               .arg(rates.bytesPerSecond / 1000.0, 0, 'f', 1)
+                               .arg(rates.framesPerSecond, 0, 'f', 0)
+                               .arg(now.queueDepth)
+                               .arg(now.checksumFailures)
+                               .arg(now.resyncs)
+                               .arg(now.partialStalls)
+                               .arg(now.maxBurstBytes)
+                               .arg(rates.avgParseNsPerBurst / 1000.0, 0, 'f', 1)
+                               .arg(plotFramesSinceStatus));
+    plotFramesSinceStatus = 0;
+}
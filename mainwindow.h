@@ -9,6 +9,10 @@
 #include <QFile>
 #include <QDateTime>
 #include <QTimer>
+#include <QThread>
+#include "asynclogger.h"
+#include "autoscale.h"
+#include "replotscheduler.h"
 #include "qcustomplot.h"
 
 
@@ -40,6 +44,29 @@ public:
 
     void initializePlot();
 
+    //Opens a port by name or device path, e.g. a jigsim pty
+    void attachPort(const QString &portName);
+
+    //Per-burst/per-frame serial notes instead of one summary a second (slow)
+    void setVerboseDiagnostics(bool verbose);
+
+    //Raw capture / replay of the serial stream, see serialPortHandler
+    void startCapture(const QString &fileName);
+    void startReplay(const QString &fileName, double speed);
+
+    //Show only the newest samples instead of the whole run, 0 = whole run
+    void setFollowWindow(int samples);
+
+    //Live plot frame rate, optionally synced to the display refresh
+    void setPlotPacing(double framesPerSecond, bool vsync);
+
+    //Rasterize live graph frames on a worker thread, the GUI thread only records them
+    void setThreadedPlotRendering(bool enabled);
+
+    void plotLiveFrames(const liveFrame *frames, int count);
+    void appendNewSamplesToGraph();
+    void resetLiveRun();
+
 
 private slots:
     void onPortSelected(const QString &portName);
@@ -54,7 +81,11 @@ private slots:
 
     void on_pushButton_start_clicked();
 
-    void recvLivePlotData(QByteArray &recvData);
+    void recvLivePlotData();
+
+    void renderLiveFrame();
+
+    void onPlotCompleted();
 
     void on_pushButton_getPower_clicked();
 
@@ -62,24 +93,54 @@ private slots:
 
     void on_pushButton_getPowerStop_clicked();
 
+    void updateIngestStatus();
+
 signals:
     void sendMsgId(quint8 id);
+    void openPort(const QString &portName);
+    void sendCommand(const QByteArray &command);
+    void diagnosticsModeRequested(int mode);
+    void captureRequested(const QString &fileName);
+    void replayRequested(const QString &fileName, double speed);
 
 private:
     Ui::MainWindow *ui;
     serialPortHandler *serialObj;
 
-    //Log handling
-    static QFile logFile;
-    static QTextStream logStream;
+    //Port, framing and decoding run here so a slow replot never backs up the driver
+    QThread *acqThread;
+
+    //Log handling, written out in batches by the logger thread
+    static asyncLogger *logger;
+
+    //Ingest telemetry shown in the status bar
+    QTimer *statsTimer = nullptr;
+    ingestSnapshot lastStats;
 
     //Response Time waiting timer
     QTimer *responseTimer = nullptr; // Timer to track response timeout
 
     // Initialize sample number
     int sampleNumber = 0;
-    QVector<double> allXValues;
-    QVector<double> allYValues;
+
+    //ADC codes decoded since the last frame, handed to the graph and cleared every frame
+    std::vector<quint16> liveCodes;
+
+    //Live channel graph, keys are implicit sample numbers so only values are kept
+    QCPUniformGraph *liveGraph = nullptr;
+
+    //Autoscale from running/windowed extrema instead of rescanning the samples
+    int followWindow = 0;
+    windowedMinMax liveWindow;
+    runningMinMax liveExtremes; //whole run
+    axisAutoscaler yAutoscale;
+
+    //Coalesces live updates into paced replots
+    replotScheduler *liveReplot = nullptr;
+    int plotFramesSinceStatus = 0; //rendered frames, shown by updateIngestStatus()
+
+    //Destination for frames popped off the live ring
+    std::vector<liveFrame> liveScratch;
 
     bool stopFlag;
 
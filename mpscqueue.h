@@ -0,0 +1,109 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+// Bounded lock-free multi-producer/single-consumer queue (Vyukov's bounded
+// queue with per-cell sequence numbers). Any thread may push(); one thread
+// pops. push() never blocks: it returns false when the queue is full so the
+// caller can count the loss instead of waiting.
+template<typename T>
+class mpscQueue
+{
+public:
+    explicit mpscQueue(size_t capacity = 1 << 14)
+    {
+        size_t cap = 2;
+        while(cap < capacity)
+            cap <<= 1;
+        mask = cap - 1;
+        cells = std::vector<cell>(cap);
+        for(size_t i = 0; i < cap; ++i)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        enqueuePos.store(0, std::memory_order_relaxed);
+        dequeuePos.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Approximate number of queued items, for wake-up heuristics only.
+    size_t sizeApprox() const
+    {
+        const size_t d = dequeuePos.load(std::memory_order_relaxed);
+        const size_t e = enqueuePos.load(std::memory_order_relaxed);
+        return e >= d ? e - d : 0;
+    }
+
+    template<typename U>
+    bool push(U &&value)
+    {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        cell *c;
+        for(;;)
+        {
+            c = &cells[pos & mask];
+            const size_t seq = c->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if(diff == 0)
+            {
+                if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if(diff < 0)
+            {
+                return false; //full
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        c->data = std::forward<U>(value);
+        c->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only.
+    bool pop(T &out)
+    {
+        const size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        cell *c = &cells[pos & mask];
+        const size_t seq = c->sequence.load(std::memory_order_acquire);
+        if(seq != pos + 1)
+            return false; //empty, or the producer of this slot has not finished yet
+
+        out = std::move(c->data);
+        c->sequence.store(pos + mask + 1, std::memory_order_release);
+        dequeuePos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    struct cell
+    {
+        cell() : sequence(0) {}
+        cell(const cell &) : sequence(0) {}
+        cell &operator=(const cell &) { return *this; }
+
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    std::vector<cell> cells;
+    size_t mask;
+
+    // Producers and the consumer update their positions on separate cache
+    // lines. Padded rather than alignas(64), which C++11 operator new does not
+    // honour for the heap-allocated asyncLogger that owns the queue.
+    enum { CacheLineSize = 64 };
+    char padBeforeEnqueue[CacheLineSize];
+    std::atomic<size_t> enqueuePos;
+    char padBeforeDequeue[CacheLineSize - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeuePos;
+    char padAfterDequeue[CacheLineSize - sizeof(std::atomic<size_t>)];
+};
+
+#endif // MPSCQUEUE_H
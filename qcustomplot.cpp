@@ -25,6 +25,18 @@
 
 #include "qcustomplot.h"
 
+// vector kernels of the adaptive sampling (QCPGraph::expandPixelInterval), chosen at compile time;
+// define QCP_NO_SIMD to use the scalar loop only
+#ifndef QCP_NO_SIMD
+#  if defined(__AVX__)
+#    define QCP_SIMD_AVX
+#    include <immintrin.h>
+#  elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define QCP_SIMD_SSE2
+#    include <emmintrin.h>
+#  endif
+#endif
+
 
 /* including file 'src/vector2d.cpp'       */
 /* modified 2022-11-06T12:45:56, size 7973 */
@@ -13627,7 +13639,11 @@ QCustomPlot::QCustomPlot(QWidget *parent) :
   mReplotTimeAverage(0),
   mOpenGlMultisamples(16),
   mOpenGlAntialiasedElementsBackup(QCP::aeNone),
-  mOpenGlCacheLabelsBackup(true)
+  mOpenGlCacheLabelsBackup(true),
+  mStreamingPool(nullptr),
+  mStreamingJobRunning(false),
+  mStreamingPending(false),
+  mStreamingGeneration(0)
 {
   setAttribute(Qt::WA_NoMousePropagation);
   setFocusPolicy(Qt::ClickFocus);
@@ -13694,6 +13710,8 @@ QCustomPlot::QCustomPlot(QWidget *parent) :
 
 QCustomPlot::~QCustomPlot()
 {
+  if (mStreamingPool) // a running rasterization job posts its frame to this instance
+    mStreamingPool->waitForDone();
   clearPlottables();
   clearItems();
 
@@ -14101,6 +14119,54 @@ void QCustomPlot::setOpenGl(bool enabled, int multisampling)
 #endif
 }
 
+/*!
+  Marks \a plottable as the plottable whose data changes continuously, e.g. a live signal. It is
+  moved to a layer of its own named "streaming", created directly above its current layer in mode
+  \ref QCPLayer::lmBuffered. \ref replotStreaming can then redraw just that layer while the axes,
+  grid, legend and all other plottables keep their paint buffers.
+
+  Only one plottable can be streaming. Setting another one, or \c nullptr, moves the previous one
+  back to the layer it came from, and removes the "streaming" layer once it is empty. Frames of the
+  previous one that are still being rasterized (see \ref QCP::phThreadedStreaming) are discarded.
+
+  \see replotStreaming
+*/
+void QCustomPlot::setStreamingPlottable(QCPAbstractPlottable *plottable)
+{
+  if (plottable == mStreamingPlottable)
+    return;
+  if (plottable && plottable->parentPlot() != this)
+  {
+    qDebug() << Q_FUNC_INFO << "plottable not in this QCustomPlot:" << reinterpret_cast<quintptr>(plottable);
+    return;
+  }
+  
+  QCPLayer *streamingLayer = layer(QLatin1String("streaming"));
+  if (mStreamingPlottable)
+    mStreamingPlottable->setLayer(mStreamingRestoreLayer ? mStreamingRestoreLayer.data() : mCurrentLayer);
+  mStreamingPlottable = plottable;
+  mStreamingView.clear();
+  // frames still being recorded or rasterized show the previous streaming plottable:
+  ++mStreamingGeneration;
+  mStreamingPending = false;
+  mStreamingPendingPicture = QPicture();
+  
+  if (plottable)
+  {
+    if (!streamingLayer)
+    {
+      addLayer(QLatin1String("streaming"), plottable->layer(), limAbove);
+      streamingLayer = layer(QLatin1String("streaming"));
+      streamingLayer->setMode(QCPLayer::lmBuffered);
+    }
+    mStreamingRestoreLayer = plottable->layer() != streamingLayer ? plottable->layer() : nullptr;
+    plottable->setLayer(streamingLayer);
+  } else if (streamingLayer && streamingLayer->children().isEmpty())
+  {
+    removeLayer(streamingLayer);
+  }
+}
+
 /*!
   Sets the viewport of this QCustomPlot. Usually users of QCustomPlot don't need to change the
   viewport manually.
@@ -15111,7 +15177,8 @@ void QCustomPlot::deselectAll()
 
   If a layer is in mode \ref QCPLayer::lmBuffered (\ref QCPLayer::setMode), it is also possible to
   replot only that specific layer via \ref QCPLayer::replot. See the documentation there for
-  details.
+  details. For a plottable whose data changes continuously, see \ref setStreamingPlottable and
+  \ref replotStreaming.
   
   \see replotTime
 */
@@ -15148,6 +15215,12 @@ void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
     layer->drawToPaintBuffer();
   foreach (QSharedPointer<QCPAbstractPaintBuffer> buffer, mPaintBuffers)
     buffer->setInvalidated(false);
+  if (mStreamingPlottable)
+    mStreamingView = streamingView();
+  // frames still being rasterized on the worker show an older state than this replot:
+  ++mStreamingGeneration;
+  mStreamingPending = false;
+  mStreamingPendingPicture = QPicture();
   
   if ((refreshPriority == rpRefreshHint && mPlottingHints.testFlag(QCP::phImmediateRefresh)) || refreshPriority==rpImmediateRefresh)
     repaint();
@@ -15168,6 +15241,67 @@ void QCustomPlot::replot(QCustomPlot::RefreshPriority refreshPriority)
   mReplotting = false;
 }
 
+/*!
+  Refreshes the plot after only the data of the streaming plottable (\ref setStreamingPlottable)
+  changed. If its axes, their scale and the axis rect are the same as at the last full \ref replot,
+  only the "streaming" layer is redrawn into its paint buffer and the widget repaints from the
+  buffers, the other layers are not touched. Otherwise, e.g. after a range change, or if there is
+  no streaming plottable, this falls back to a full \ref replot with \a refreshPriority.
+
+  Like \ref QCPLayer::replot, a layer-only refresh doesn't emit \ref beforeReplot and \ref
+  afterReplot and doesn't update \ref replotTime.
+
+  With the plotting hint \ref QCP::phThreadedStreaming, a layer-only refresh just records the
+  drawing of the streaming layer in a QPicture, which holds the data already converted to pixel
+  coordinates. A worker thread rasterizes the recording into a QImage while the GUI thread returns
+  to its event loop, and the finished image replaces the layer's paint buffer in one step before the
+  widget repaints. The widget keeps showing the previous frame until then. If recordings arrive
+  faster than the worker rasterizes them, only the newest one is rasterized next.
+
+  \see setStreamingPlottable
+*/
+void QCustomPlot::replotStreaming(QCustomPlot::RefreshPriority refreshPriority)
+{
+  if (mReplotting)
+    return;
+  if (refreshPriority == rpQueuedReplot || !mStreamingPlottable || mStreamingView.isEmpty() || hasInvalidatedPaintBuffers())
+  {
+    replot(refreshPriority);
+    return;
+  }
+  QCPLayer *streamingLayer = mStreamingPlottable->layer();
+  QSharedPointer<QCPAbstractPaintBuffer> pb = streamingLayer->mPaintBuffer.toStrongRef();
+  if (!pb || streamingLayer->mode() != QCPLayer::lmBuffered || streamingView() != mStreamingView)
+  {
+    replot(refreshPriority);
+    return;
+  }
+  
+  if (mPlottingHints.testFlag(QCP::phThreadedStreaming) && !mOpenGl)
+  {
+    QPicture picture;
+    QCPPainter painter(&picture);
+    streamingLayer->draw(&painter);
+    painter.end();
+    if (mStreamingJobRunning)
+    {
+      mStreamingPendingPicture = picture;
+      mStreamingPending = true;
+    } else
+      startStreamingJob(picture);
+    return; // processStreamingFrame refreshes the widget
+  }
+  
+  pb->clear(Qt::transparent);
+  streamingLayer->drawToPaintBuffer();
+  pb->setInvalidated(false); // the layer is lmBuffered, so it is the only one on this buffer
+  
+  if ((refreshPriority == rpRefreshHint && mPlottingHints.testFlag(QCP::phImmediateRefresh)) || refreshPriority==rpImmediateRefresh)
+    repaint();
+  else
+    update();
+}
+
 /*!
   Returns the time in milliseconds that the last replot took. If \a average is set to true, an
   exponential moving average over the last couple of replots is returned.
@@ -15919,6 +16053,136 @@ bool QCustomPlot::hasInvalidatedPaintBuffers()
   return false;
 }
 
+/*! \internal
+
+  Rasterizes a recording of the streaming layer (see \ref replotStreaming) into a transparent
+  QImage of the paint buffer's size on the worker thread, and hands the image back to the
+  QCustomPlot with a queued \ref QCustomPlot::processStreamingFrame call. The job only touches the
+  recording and its own image, never the QCustomPlot's objects.
+*/
+class QCPStreamingRasterJob : public QRunnable
+{
+public:
+  QCPStreamingRasterJob(QCustomPlot *parentPlot, const QPicture &picture, const QSize &size, double devicePixelRatio, quint64 generation) :
+    mParentPlot(parentPlot),
+    mPicture(picture),
+    mSize(size),
+    mDevicePixelRatio(devicePixelRatio),
+    mGeneration(generation)
+  {}
+  
+  virtual void run() Q_DECL_OVERRIDE
+  {
+#ifdef QCP_DEVICEPIXELRATIO_SUPPORTED
+    QImage image(mSize*mDevicePixelRatio, QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(mDevicePixelRatio);
+#else
+    QImage image(mSize, QImage::Format_ARGB32_Premultiplied);
+#endif
+    image.fill(Qt::transparent);
+    QCPPainter painter(&image);
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    painter.setRenderHint(QPainter::HighQualityAntialiasing); // like QCPPaintBufferPixmap::startPainting
+#endif
+    painter.drawPicture(0, 0, mPicture);
+    painter.end();
+    QMetaObject::invokeMethod(mParentPlot, "processStreamingFrame", Qt::QueuedConnection, Q_ARG(QImage, image), Q_ARG(quint64, mGeneration));
+  }
+  
+private:
+  QCustomPlot *mParentPlot; // only used to post the result, the destructor of QCustomPlot waits for the job
+  QPicture mPicture;
+  QSize mSize;
+  double mDevicePixelRatio;
+  quint64 mGeneration;
+};
+
+/*! \internal
+
+  Starts rasterizing \a picture, a recording of the streaming layer, on the worker thread. Only one
+  job runs at a time.
+
+  \see replotStreaming, processStreamingFrame
+*/
+void QCustomPlot::startStreamingJob(const QPicture &picture)
+{
+  QSharedPointer<QCPAbstractPaintBuffer> pb;
+  if (mStreamingPlottable && mStreamingPlottable->layer())
+    pb = mStreamingPlottable->layer()->mPaintBuffer.toStrongRef();
+  if (!pb)
+    return;
+  if (!mStreamingPool)
+  {
+    mStreamingPool = new QThreadPool(this);
+    mStreamingPool->setMaxThreadCount(1);
+  }
+  mStreamingJobRunning = true;
+  mStreamingPool->start(new QCPStreamingRasterJob(this, picture, pb->size(), pb->devicePixelRatio(), mStreamingGeneration));
+}
+
+/*! \internal
+
+  Receives a rasterized frame of the streaming layer from the worker thread. If no full replot
+  happened since its recording was made (\a generation) and the paint buffers are still valid, the
+  image replaces the content of the streaming layer's paint buffer and the widget is repainted.
+  Then the newest recording made in the meantime, if any, is rasterized next.
+
+  \see replotStreaming
+*/
+void QCustomPlot::processStreamingFrame(const QImage &image, quint64 generation)
+{
+  mStreamingJobRunning = false;
+  if (generation == mStreamingGeneration && mStreamingPlottable && !hasInvalidatedPaintBuffers())
+  {
+    QCPLayer *streamingLayer = mStreamingPlottable->layer();
+    QSharedPointer<QCPAbstractPaintBuffer> pb = streamingLayer->mPaintBuffer.toStrongRef();
+    if (pb && streamingLayer->mode() == QCPLayer::lmBuffered)
+    {
+      pb->clear(Qt::transparent);
+      if (QCPPainter *painter = pb->startPainting())
+      {
+        painter->setCompositionMode(QPainter::CompositionMode_Source);
+        painter->drawImage(0, 0, image);
+        delete painter;
+        pb->donePainting();
+      }
+      pb->setInvalidated(false);
+      update();
+    }
+  }
+  if (mStreamingPending)
+  {
+    mStreamingPending = false;
+    const QPicture picture = mStreamingPendingPicture;
+    mStreamingPendingPicture = QPicture();
+    startStreamingJob(picture);
+  }
+}
+
+/*! \internal
+
+  Returns what determines where the streaming plottable is drawn: range, scale type and direction
+  of its key and value axis, and the rect of its axis rect. \ref replotStreaming compares this to
+  the state at the last full replot to decide whether redrawing only the streaming layer is enough.
+  Returns an empty vector if there is no streaming plottable or it lacks axes.
+*/
+QVector<double> QCustomPlot::streamingView() const
+{
+  QVector<double> view;
+  if (!mStreamingPlottable)
+    return view;
+  QCPAxis *keyAxis = mStreamingPlottable->keyAxis();
+  QCPAxis *valueAxis = mStreamingPlottable->valueAxis();
+  if (!keyAxis || !valueAxis)
+    return view;
+  const QRect axisRect = keyAxis->axisRect()->rect();
+  view.reserve(12);
+  view << keyAxis->range().lower << keyAxis->range().upper << keyAxis->scaleType() << keyAxis->rangeReversed()
+       << valueAxis->range().lower << valueAxis->range().upper << valueAxis->scaleType() << valueAxis->rangeReversed()
+       << axisRect.left() << axisRect.top() << axisRect.width() << axisRect.height();
+  return view;
+}
+
 /*! \internal
 
   When \ref setOpenGl is set to true, this method is used to initialize OpenGL (create a context,
@@ -21703,69 +21967,39 @@ void QCPGraph::getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGr
   
   int dataCount = int(end-begin);
   int maxCount = (std::numeric_limits<int>::max)();
+  double keyPixelSpan = 0;
   if (mAdaptiveSampling)
   {
-    double keyPixelSpan = qAbs(keyAxis->coordToPixel(begin->key)-keyAxis->coordToPixel((end-1)->key));
+    keyPixelSpan = qAbs(keyAxis->coordToPixel(begin->key)-keyAxis->coordToPixel((end-1)->key));
     if (2*keyPixelSpan+2 < static_cast<double>((std::numeric_limits<int>::max)()))
       maxCount = int(2*keyPixelSpan+2);
   }
   
-  if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
+  if (mAdaptiveSampling && dataCount >= maxCount && keyAxis->scaleType() == QCPAxis::stLinear)
   {
-    QCPGraphDataContainer::const_iterator it = begin;
-    double minValue = it->value;
-    double maxValue = it->value;
-    QCPGraphDataContainer::const_iterator currentIntervalFirstPoint = it;
-    int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
-    int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
-    double currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(begin->key)+reversedRound));
-    double lastIntervalEndKey = currentIntervalStartKey;
-    double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
-    bool keyEpsilonVariable = keyAxis->scaleType() == QCPAxis::stLogarithmic; // indicates whether keyEpsilon needs to be updated after every interval (for log axes)
-    int intervalDataCount = 1;
-    ++it; // advance iterator to second data point because adaptive sampling works in 1 point retrospect
-    while (it != end)
+    // with a level of detail index, walk precomputed min/max buckets instead of every point
+    if (const QCPDataLevelOfDetail *lod = mDataContainer->levelOfDetailIndex())
     {
-      if (it->key < currentIntervalStartKey+keyEpsilon) // data point is still within same pixel, so skip it and expand value span of this cluster if necessary
-      {
-        if (it->value < minValue)
-          minValue = it->value;
-        else if (it->value > maxValue)
-          maxValue = it->value;
-        ++intervalDataCount;
-      } else // new pixel interval started
+      const int level = lod->levelForDensity(dataCount/qMax(keyPixelSpan, 1.0));
+      if (level > 0)
       {
-        if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
-        {
-          if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point is further away, so first point of this cluster must be at a real data point
-            lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, currentIntervalFirstPoint->value));
-          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
-          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
-          if (it->key > currentIntervalStartKey+keyEpsilon*2) // new pixel started further away from previous cluster, so make sure the last point of the cluster is at a real data point
-            lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.8, (it-1)->value));
-        } else
-          lineData->append(QCPGraphData(currentIntervalFirstPoint->key, currentIntervalFirstPoint->value));
-        lastIntervalEndKey = (it-1)->key;
-        minValue = it->value;
-        maxValue = it->value;
-        currentIntervalFirstPoint = it;
-        currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(it->key)+reversedRound));
-        if (keyEpsilonVariable)
-          keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
-        intervalDataCount = 1;
+        const int beginIndex = int(begin-mDataContainer->constBegin());
+        getLevelOfDetailLineData(lineData, *lod, beginIndex, beginIndex+dataCount, level);
+        return;
       }
-      ++it;
     }
-    // handle last interval:
-    if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
-    {
-      if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point wasn't a cluster, so first point of this cluster must be at a real data point
-        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, currentIntervalFirstPoint->value));
-      lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
-      lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
-    } else
-      lineData->append(QCPGraphData(currentIntervalFirstPoint->key, currentIntervalFirstPoint->value));
-    
+  }
+  
+  if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
+  {
+    int reversedRound = keyAxis->pixelOrientation()==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
+    double firstIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(begin->key)+reversedRound));
+    double keyEpsilon = qAbs(firstIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(firstIntervalStartKey)+1.0*keyAxis->pixelOrientation())); // interval of one pixel on screen when mapped to plot key coordinates
+    // large graphs are sampled in pixel-aligned shards on the thread pool:
+    const int minShardDataCount = 1 << 18; // below this, handing the work to other threads costs more than it saves
+    const int shardCount = qMin(QThread::idealThreadCount(), qMin(dataCount/minShardDataCount, int(keyPixelSpan/16)));
+    if (shardCount < 2 || !getParallelLineData(lineData, begin, end, keyEpsilon, shardCount))
+      getAdaptiveLineData(lineData, nullptr, begin, end, 0, dataCount, keyEpsilon);
   } else // don't use adaptive sampling algorithm, transfer points one-to-one from the data container into the output
   {
     lineData->resize(dataCount);
@@ -21773,6 +22007,408 @@ void QCPGraph::getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGr
   }
 }
 
+/*! \internal
+
+  The adaptive sampling of \ref getOptimizedLineData for the data points from index \a first
+  (relative to \a begin) on: consecutive data points within one pixel are consolidated to a
+  cluster of at most four points. \a keyEpsilon is the key span of one pixel at the first interval
+  of the whole sampled range (recalculated per interval on logarithmic axes).
+
+  If \a first is 0, the result is the serial sampling of the whole range up to \a end. Otherwise
+  \a first is expected to be where a pixel interval starts, so the result continues the serial
+  sampling from there. The sampling ends at the first interval that starts at or beyond index \a
+  stop: its index is returned, after the preceding cluster was completed with it. If the data ends
+  first, the last interval is completed and the number of data points is returned.
+
+  If \a intervalStarts is not \c nullptr, it receives for every interval the index of its first
+  data point and the size of \a lineData before its cluster was appended, so \ref
+  getParallelLineData can stitch shards at any interval.
+*/
+int QCPGraph::getAdaptiveLineData(QVector<QCPGraphData> *lineData, QVector<QPair<int, int> > *intervalStarts, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end, int first, int stop, double keyEpsilon) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPGraphDataContainer::const_iterator it = begin+first;
+  double minValue = it->value;
+  double maxValue = it->value;
+  QCPGraphDataContainer::const_iterator currentIntervalFirstPoint = it;
+  int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
+  int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
+  double currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(it->key)+reversedRound));
+  double lastIntervalEndKey = first == 0 ? currentIntervalStartKey : (it-1)->key;
+  bool keyEpsilonVariable = keyAxis->scaleType() == QCPAxis::stLogarithmic; // indicates whether keyEpsilon needs to be updated after every interval (for log axes)
+  if (keyEpsilonVariable)
+    keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
+  if (intervalStarts)
+    intervalStarts->append(qMakePair(first, lineData->size()));
+  int intervalDataCount = 1;
+  ++it; // advance iterator to second data point because adaptive sampling works in 1 point retrospect
+  while (it != end)
+  {
+    if (it->key < currentIntervalStartKey+keyEpsilon) // data point is still within same pixel, so skip the whole run of such points and expand value span of this cluster if necessary
+    {
+      QCPGraphDataContainer::const_iterator runEnd = expandPixelInterval(it, end, currentIntervalStartKey+keyEpsilon, minValue, maxValue);
+      intervalDataCount += int(runEnd-it);
+      it = runEnd;
+    } else // new pixel interval started
+    {
+      if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+      {
+        if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point is further away, so first point of this cluster must be at a real data point
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, currentIntervalFirstPoint->value));
+        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+        if (it->key > currentIntervalStartKey+keyEpsilon*2) // new pixel started further away from previous cluster, so make sure the last point of the cluster is at a real data point
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.8, (it-1)->value));
+      } else
+        lineData->append(QCPGraphData(currentIntervalFirstPoint->key, currentIntervalFirstPoint->value));
+      const int index = int(it-begin);
+      if (index >= stop) // this interval is sampled by the next shard
+        return index;
+      lastIntervalEndKey = (it-1)->key;
+      minValue = it->value;
+      maxValue = it->value;
+      currentIntervalFirstPoint = it;
+      currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(it->key)+reversedRound));
+      if (keyEpsilonVariable)
+        keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
+      if (intervalStarts)
+        intervalStarts->append(qMakePair(index, lineData->size()));
+      intervalDataCount = 1;
+      ++it;
+    }
+  }
+  // handle last interval:
+  if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+  {
+    if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point wasn't a cluster, so first point of this cluster must be at a real data point
+      lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, currentIntervalFirstPoint->value));
+    lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+    lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+  } else
+    lineData->append(QCPGraphData(currentIntervalFirstPoint->key, currentIntervalFirstPoint->value));
+  return int(end-begin);
+}
+
+/*! \internal
+
+  Samples one shard of \ref QCPGraph::getParallelLineData on a thread of the pool. Only reads the
+  data and the key axis, which the waiting GUI thread doesn't change meanwhile.
+*/
+class QCPGraphLineDataJob : public QRunnable
+{
+public:
+  QCPGraphLineDataJob(const QCPGraph *graph, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end, int first, int stop, double keyEpsilon, QSemaphore *done) :
+    mGraph(graph), mBegin(begin), mEnd(end), mFirst(first), mStop(stop), mKeyEpsilon(keyEpsilon), mDone(done), mClosedAt(0)
+  {
+    setAutoDelete(false); // owned by getParallelLineData, which also runs it if no thread is free
+  }
+  
+  virtual void run() Q_DECL_OVERRIDE
+  {
+    mClosedAt = mGraph->getAdaptiveLineData(&mLineData, &mIntervalStarts, mBegin, mEnd, mFirst, mStop, mKeyEpsilon);
+    if (mDone)
+      mDone->release();
+  }
+  
+  const QCPGraph *mGraph;
+  QCPGraphDataContainer::const_iterator mBegin, mEnd;
+  int mFirst, mStop;
+  double mKeyEpsilon;
+  QSemaphore *mDone; // released when a pool thread ran the job, nullptr when run inline
+  int mClosedAt;
+  QVector<QCPGraphData> mLineData;
+  QVector<QPair<int, int> > mIntervalStarts;
+};
+
+/*! \internal
+
+  Splits the adaptive sampling of the data points between \a begin and \a end into \a shardCount
+  shards at pixel boundaries and samples them concurrently with \ref getAdaptiveLineData, the
+  first one on this thread and the others on the global QThreadPool (or on this thread too, if no
+  pool thread is free).
+
+  A shard starts where the serial sampling would start a pixel interval if the preceding points
+  close their interval at the shard boundary. The shards are joined in order: each shard samples
+  past its end until its last interval is closed, and the following shard's output is appended
+  from the interval that starts at that data point on. Since an interval depends only on the pixel
+  of its first point, both agree from there, and \a lineData is identical to the serial result.
+
+  Returns false without changing \a lineData if the shards can't be joined this way (when an
+  interval runs across a whole shard), so the caller samples serially.
+*/
+bool QCPGraph::getParallelLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end, double keyEpsilon, int shardCount) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  const int dataCount = int(end-begin);
+  const int reversedRound = keyAxis->pixelOrientation()==-1 ? 1 : 0;
+  const double firstKey = begin->key;
+  const double lastKey = (end-1)->key;
+  
+  // first data point of each shard, at the first key of a pixel interval:
+  QVector<int> firsts;
+  firsts << 0;
+  for (int i=1; i<shardCount; ++i)
+  {
+    const double splitKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(firstKey+(lastKey-firstKey)*i/double(shardCount))+reversedRound));
+    const int index = int(std::lower_bound(begin, end, QCPGraphData::fromSortKey(splitKey), qcpLessThanSortKey<QCPGraphData>)-begin);
+    if (index > firsts.last() && index < dataCount)
+      firsts << index;
+  }
+  if (firsts.size() < 2)
+    return false;
+  
+  QSemaphore done;
+  int started = 0;
+  QVector<QCPGraphLineDataJob*> jobs;
+  for (int i=0; i<firsts.size(); ++i)
+    jobs.append(new QCPGraphLineDataJob(this, begin, end, firsts.at(i), i+1 < firsts.size() ? firsts.at(i+1) : dataCount, keyEpsilon, i > 0 ? &done : nullptr));
+  for (int i=1; i<jobs.size(); ++i)
+  {
+    if (QThreadPool::globalInstance()->tryStart(jobs.at(i)))
+      ++started;
+    else
+      jobs.at(i)->mDone = nullptr;
+  }
+  for (int i=0; i<jobs.size(); ++i)
+  {
+    if (!jobs.at(i)->mDone)
+      jobs.at(i)->run();
+  }
+  done.acquire(started);
+  
+  // join the shards where the previous one closed its last interval:
+  QVector<QCPGraphData> result = jobs.first()->mLineData;
+  int closedAt = jobs.first()->mClosedAt;
+  int shard = 1;
+  bool joined = true;
+  while (closedAt < dataCount && joined)
+  {
+    joined = false;
+    for (; shard < jobs.size() && closedAt >= jobs.at(shard)->mFirst; ++shard)
+    {
+      const QCPGraphLineDataJob *job = jobs.at(shard);
+      QVector<QPair<int, int> >::const_iterator start = std::lower_bound(job->mIntervalStarts.constBegin(), job->mIntervalStarts.constEnd(), qMakePair(closedAt, -1));
+      if (start != job->mIntervalStarts.constEnd() && start->first == closedAt)
+      {
+        for (int i=start->second; i<job->mLineData.size(); ++i)
+          result.append(job->mLineData.at(i));
+        closedAt = job->mClosedAt;
+        ++shard;
+        joined = true;
+        break;
+      }
+    }
+  }
+  qDeleteAll(jobs);
+  if (!joined)
+    return false;
+  *lineData << result;
+  return true;
+}
+
+/*! \internal
+
+  Visits the data points from \a begin on as long as their key is smaller than \a keyLimit, the
+  key where the current pixel interval of the adaptive sampling ends, and expands \a minValue and
+  \a maxValue by their values. Returns the first data point at or beyond \a keyLimit, or \a end.
+
+  The result is the same as comparing one point at a time like the adaptive sampling of \ref
+  getOptimizedLineData did: NaN values are skipped, but if \a minValue and \a maxValue start out
+  as NaN (the first point of the interval was NaN), they stay NaN. Depending on the build, two
+  (SSE2) or four (AVX) data points are tested and folded in per step while all of them are inside
+  the interval; the points at its end are handled one by one.
+*/
+QCPGraphDataContainer::const_iterator QCPGraph::expandPixelInterval(const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end, double keyLimit, double &minValue, double &maxValue)
+{
+  const int count = int(end-begin);
+  if (count <= 0)
+    return begin;
+  const QCPGraphData *data = &*begin;
+  int i = 0;
+#if defined(QCP_SIMD_AVX) || defined(QCP_SIMD_SSE2)
+  Q_STATIC_ASSERT(sizeof(QCPGraphData) == 2*sizeof(double)); // key and value interleaved without padding
+  double spanMin = std::numeric_limits<double>::infinity();
+  double spanMax = -std::numeric_limits<double>::infinity();
+#  if defined(QCP_SIMD_AVX)
+  {
+    const __m256d limit = _mm256_set1_pd(keyLimit);
+    __m256d lower = _mm256_set1_pd(spanMin);
+    __m256d upper = _mm256_set1_pd(spanMax);
+    for (; i+4 <= count; i += 4)
+    {
+      const __m256d a = _mm256_loadu_pd(&data[i].key); // key0 value0 key1 value1
+      const __m256d b = _mm256_loadu_pd(&data[i+2].key); // key2 value2 key3 value3
+      if (_mm256_movemask_pd(_mm256_cmp_pd(_mm256_unpacklo_pd(a, b), limit, _CMP_LT_OQ)) != 0xF)
+        break;
+      const __m256d values = _mm256_unpackhi_pd(a, b);
+      lower = _mm256_min_pd(values, lower); // returns the second operand for NaN, so NaN values are skipped
+      upper = _mm256_max_pd(values, upper);
+    }
+    double lowers[4], uppers[4];
+    _mm256_storeu_pd(lowers, lower);
+    _mm256_storeu_pd(uppers, upper);
+    for (int k=0; k<4; ++k)
+    {
+      if (lowers[k] < spanMin) spanMin = lowers[k];
+      if (uppers[k] > spanMax) spanMax = uppers[k];
+    }
+  }
+#  else
+  {
+    const __m128d limit = _mm_set1_pd(keyLimit);
+    __m128d lower = _mm_set1_pd(spanMin);
+    __m128d upper = _mm_set1_pd(spanMax);
+    for (; i+2 <= count; i += 2)
+    {
+      const __m128d a = _mm_loadu_pd(&data[i].key); // key0 value0
+      const __m128d b = _mm_loadu_pd(&data[i+1].key); // key1 value1
+      if (_mm_movemask_pd(_mm_cmplt_pd(_mm_unpacklo_pd(a, b), limit)) != 0x3)
+        break;
+      const __m128d values = _mm_unpackhi_pd(a, b);
+      lower = _mm_min_pd(values, lower); // returns the second operand for NaN, so NaN values are skipped
+      upper = _mm_max_pd(values, upper);
+    }
+    double lowers[2], uppers[2];
+    _mm_storeu_pd(lowers, lower);
+    _mm_storeu_pd(uppers, upper);
+    for (int k=0; k<2; ++k)
+    {
+      if (lowers[k] < spanMin) spanMin = lowers[k];
+      if (uppers[k] > spanMax) spanMax = uppers[k];
+    }
+  }
+#  endif
+  // comparisons with NaN are false, so a NaN span from the interval's first point is kept:
+  if (spanMin < minValue)
+    minValue = spanMin;
+  if (spanMax > maxValue)
+    maxValue = spanMax;
+#endif
+  for (; i<count && data[i].key < keyLimit; ++i)
+  {
+    if (data[i].value < minValue)
+      minValue = data[i].value;
+    else if (data[i].value > maxValue)
+      maxValue = data[i].value;
+  }
+  return begin+i;
+}
+
+/*! \internal
+
+  Same clustering as the adaptive sampling branch of \ref getOptimizedLineData, but the data
+  points between \a beginIndex and \a endIndex are visited as whole buckets of the level of detail
+  index \a lod wherever a bucket at \a level (or a finer one) is aligned, complete and ends within
+  the pixel interval its first point belongs to. Only the points at the edges of the range, at
+  pixel boundaries or around gaps in the keys are visited one by one, so the work is proportional
+  to the number of pixels rather than the number of data points, and the result is the same as
+  that of the adaptive sampling. Only used for linear key axes.
+*/
+void QCPGraph::getLevelOfDetailLineData(QVector<QCPGraphData> *lineData, const QCPDataLevelOfDetail &lod, int beginIndex, int endIndex, int level) const
+{
+  QCPAxis *keyAxis = mKeyAxis.data();
+  const QCPGraphDataContainer::const_iterator data = mDataContainer->constBegin();
+  
+  // a run of consecutive data points treated as one: a single point or a bucket of the index
+  struct Unit
+  {
+    double firstKey, lastKey, firstValue, lastValue, minValue, maxValue;
+    int count;
+  };
+  
+  int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
+  int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
+  double currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(data[beginIndex].key)+reversedRound));
+  const double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
+  
+  // returns the largest unit starting at index whose keys all lie below keyLimit, the end of the
+  // pixel interval of its first point, falling back to finer levels and finally single points
+  auto unitAt = [&](int index, double keyLimit) -> Unit
+  {
+    Unit u;
+    for (int l=level; l>=QCPDataLevelOfDetail::MinLevel; --l)
+    {
+      const int size = 1 << l;
+      if ((index & (size-1)) == 0 && index+size <= endIndex && (index >> l) < lod.bucketCount(l))
+      {
+        const QCPGraphData &first = data[index];
+        const QCPGraphData &last = data[index+size-1];
+        if (last.key < keyLimit) // otherwise the bucket crosses into the next pixel interval
+        {
+          const QCPDataLevelOfDetail::Bucket &b = lod.bucket(l, index >> l);
+          u.firstKey = first.key;
+          u.lastKey = last.key;
+          u.firstValue = first.value;
+          u.lastValue = last.value;
+          u.minValue = b.min;
+          u.maxValue = b.max;
+          u.count = size;
+          return u;
+        }
+      }
+    }
+    const QCPGraphData &point = data[index];
+    u.firstKey = u.lastKey = point.key;
+    u.firstValue = u.lastValue = u.minValue = u.maxValue = point.value;
+    u.count = 1;
+    return u;
+  };
+  
+  Unit unit = unitAt(beginIndex, currentIntervalStartKey+keyEpsilon);
+  Unit firstUnit = unit; // first unit of the current pixel interval
+  Unit previousUnit = unit;
+  // like the adaptive sampling, an interval starting with NaN keeps a NaN value span:
+  double minValue = qIsNaN(unit.firstValue) ? unit.firstValue : unit.minValue;
+  double maxValue = qIsNaN(unit.firstValue) ? unit.firstValue : unit.maxValue;
+  double lastIntervalEndKey = currentIntervalStartKey;
+  int intervalDataCount = unit.count;
+  int index = beginIndex+unit.count;
+  while (index < endIndex)
+  {
+    const double key = data[index].key;
+    const bool samePixel = key < currentIntervalStartKey+keyEpsilon;
+    const double intervalStartKey = samePixel ? currentIntervalStartKey : keyAxis->pixelToCoord(int(keyAxis->coordToPixel(key)+reversedRound));
+    unit = unitAt(index, intervalStartKey+keyEpsilon);
+    if (samePixel) // unit is still within same pixel, so expand value span of this cluster if necessary
+    {
+      if (unit.minValue < minValue)
+        minValue = unit.minValue;
+      if (unit.maxValue > maxValue)
+        maxValue = unit.maxValue;
+      intervalDataCount += unit.count;
+    } else // new pixel interval started
+    {
+      if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+      {
+        if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point is further away, so first point of this cluster must be at a real data point
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, firstUnit.firstValue));
+        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+        if (unit.firstKey > currentIntervalStartKey+keyEpsilon*2) // new pixel started further away from previous cluster, so make sure the last point of the cluster is at a real data point
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.8, previousUnit.lastValue));
+      } else
+        lineData->append(QCPGraphData(firstUnit.firstKey, firstUnit.firstValue));
+      lastIntervalEndKey = previousUnit.lastKey;
+      minValue = qIsNaN(unit.firstValue) ? unit.firstValue : unit.minValue;
+      maxValue = qIsNaN(unit.firstValue) ? unit.firstValue : unit.maxValue;
+      firstUnit = unit;
+      currentIntervalStartKey = intervalStartKey;
+      intervalDataCount = unit.count;
+    }
+    previousUnit = unit;
+    index += unit.count;
+  }
+  // handle last interval:
+  if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+  {
+    if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point wasn't a cluster, so first point of this cluster must be at a real data point
+      lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, firstUnit.firstValue));
+    lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+    lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+  } else
+    lineData->append(QCPGraphData(firstUnit.firstKey, firstUnit.firstValue));
+}
+
 /*! \internal
 
   Returns via \a scatterData the data points that need to be visualized for this graph when
@@ -22492,6 +23128,1488 @@ int QCPGraph::findIndexBelowY(const QVector<QPointF> *data, double y) const
 /* end of 'src/plottables/plottable-graph.cpp' */
 
 
+/* including file 'src/plottables/plottable-uniformgraph.cpp' */
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPUniformDataContainer
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPUniformDataContainer
+  \brief Holds the data of a QCPUniformGraph: uniformly sampled values with implicit keys
+
+  Only the values are stored. The key of the data point at \a index is <tt>keyOffset +
+  index*keyStep</tt> (see \ref setKeySampling), so the data is always sorted by key and \ref
+  findBegin and \ref findEnd are O(1) arithmetic instead of a binary search. Compared to a \ref
+  QCPGraphDataContainer this halves the memory per data point.
+
+  The values can be stored more compactly as floats or as 16 bit codes, with an affine scale
+  applied when they are read (see \ref setStorageFormat and \ref setValueScale). Raw ADC codes for
+  example can be appended as they are with \ref addRaw, at 2 bytes per data point.
+
+  Values may be appended cheaply with \ref add. \ref removeFirst drops the oldest values, the keys
+  of the remaining data points don't change. With \ref setCapacity the container becomes a ring
+  buffer of the newest data points, for strip charts that stream indefinitely.
+
+  Gaps in the graph line can be created by adding NaN values.
+
+  \see QCPUniformGraph
+*/
+
+/* start documentation of inline functions */
+
+/*! \fn double QCPUniformDataContainer::key(int index) const
+
+  Returns the key of the data point at \a index, which is <tt>keyOffset + index*keyStep</tt>. The
+  index is not checked against the container size.
+*/
+
+/*! \fn double QCPUniformDataContainer::value(int index) const
+
+  Returns the value of the data point at \a index, i.e. its stored number with the value scale
+  applied.
+*/
+
+/* end documentation of inline functions */
+
+/*!
+  Constructs an empty container with key offset 0 and key step 1, i.e. the keys are the data point
+  indices.
+*/
+QCPUniformDataContainer::QCPUniformDataContainer() :
+  mKeyOffset(0),
+  mKeyStep(1),
+  mCapacity(0),
+  mFormat(sfDouble),
+  mValueOffset(0),
+  mValueScale(1),
+  mLevelOfDetail(false),
+  mHead(0),
+  mCount(0),
+  mFirstIndex(0)
+{
+}
+
+/*!
+  Sets the key of the first data point to \a keyOffset and the key distance between consecutive
+  data points to \a keyStep, which must be positive. The key of the data point at \a index is
+  <tt>keyOffset + (firstIndex + index)*keyStep</tt>, where \ref firstIndex counts the data points
+  removed from the front since the last \ref clear.
+*/
+void QCPUniformDataContainer::setKeySampling(double keyOffset, double keyStep)
+{
+  if (!(keyStep > 0) || !std::isfinite(keyStep) || !std::isfinite(keyOffset))
+  {
+    qDebug() << Q_FUNC_INFO << "invalid key sampling" << keyOffset << keyStep;
+    return;
+  }
+  mKeyOffset = keyOffset;
+  mKeyStep = keyStep;
+}
+
+/*!
+  Limits the container to the newest \a capacity data points, turning it into a ring buffer: once
+  it is full, every appended data point evicts the oldest one in O(1), and the keys move along. A
+  "last N samples" strip chart then runs at constant memory and cost however long it streams. A
+  \a capacity of 0 (the default) removes the limit.
+
+  The storage holds every data point twice, at its ring position and one capacity further, so the
+  data points are always one contiguous, key-sorted run without wrapping. The level of detail index
+  (\ref setLevelOfDetail) is not used with a capacity, the window is scanned directly.
+
+  If the container holds more than \a capacity data points, the oldest ones are removed.
+*/
+void QCPUniformDataContainer::setCapacity(int capacity)
+{
+  capacity = qMax(0, capacity);
+  if (capacity == mCapacity)
+    return;
+  QVector<double> values;
+  const int keep = capacity > 0 ? qMin(capacity, mCount) : mCount;
+  values.reserve(keep);
+  for (int i=mCount-keep; i<mCount; ++i)
+    values.append(value(i));
+  const qint64 firstIndex = mFirstIndex+(mCount-keep);
+  mCapacity = capacity;
+  resetStorage();
+  add(values);
+  mFirstIndex = firstIndex;
+}
+
+/*!
+  Sets how the values are stored. Values already in the container are converted to the new format,
+  which may round them (see \ref add).
+
+  \see setValueScale
+*/
+void QCPUniformDataContainer::setStorageFormat(StorageFormat format)
+{
+  if (format == mFormat)
+    return;
+  QVector<double> values(size());
+  for (int i=0; i<values.size(); ++i)
+    values[i] = value(i);
+  const qint64 firstIndex = mFirstIndex;
+  mFormat = format;
+  resetStorage();
+  add(values);
+  mFirstIndex = firstIndex;
+}
+
+/*!
+  Sets the affine scale between the stored numbers and the values: a stored number \a s represents
+  the value <tt>valueOffset + valueScale*s</tt>. \a valueScale may be negative but not zero.
+
+  The stored numbers are kept, so this changes the values of the data points already in the
+  container. That way raw codes can be stored once and rescaled, e.g. after a calibration.
+*/
+void QCPUniformDataContainer::setValueScale(double valueOffset, double valueScale)
+{
+  if (valueScale == 0 || !std::isfinite(valueScale) || !std::isfinite(valueOffset))
+  {
+    qDebug() << Q_FUNC_INFO << "invalid value scale" << valueOffset << valueScale;
+    return;
+  }
+  mValueOffset = valueOffset;
+  mValueScale = valueScale;
+}
+
+/*!
+  Sets whether the container keeps a \ref QCPDataLevelOfDetail index of the values. With the index,
+  the min/max span of long runs of values (see \ref expandValueSpan) is assembled from precomputed
+  buckets, so adaptive sampling of a \ref QCPUniformGraph does work proportional to the number of
+  pixels rather than the number of visible data points. The index is extended from the appended
+  values when it is next used, and rebuilt after \ref set, \ref removeFirst or \ref clear. It is not
+  used while a capacity is set (\ref setCapacity).
+*/
+void QCPUniformDataContainer::setLevelOfDetail(bool enabled)
+{
+  mLevelOfDetail = enabled;
+  mLod.invalidate();
+}
+
+/*!
+  Replaces the current values with the provided \a values, the first of them at \a keyOffset. With
+  a capacity, only the newest values are kept.
+*/
+void QCPUniformDataContainer::set(const QVector<double> &values)
+{
+  clear();
+  add(values);
+}
+
+/*!
+  Appends \a count values from the array \a values. With a capacity, the oldest data points are
+  evicted as needed.
+
+  The values are converted to stored numbers with the inverse of the value scale. For \ref sfUInt16
+  they are rounded to the nearest code and clamped to 0..65535, NaN is stored as 0.
+*/
+void QCPUniformDataContainer::add(const double *values, int count)
+{
+  const bool identity = mValueOffset == 0 && mValueScale == 1;
+  const int batchSize = 256; // converted in small batches, so the ring append can copy runs
+  while (count > 0)
+  {
+    const int n = qMin(count, batchSize);
+    switch (mFormat)
+    {
+      case sfDouble:
+      {
+        double stored[batchSize];
+        for (int i=0; i<n; ++i)
+          stored[i] = identity ? values[i] : (values[i]-mValueOffset)/mValueScale;
+        append(mValues, stored, n);
+        break;
+      }
+      case sfFloat:
+      {
+        float stored[batchSize];
+        for (int i=0; i<n; ++i)
+          stored[i] = float(identity ? values[i] : (values[i]-mValueOffset)/mValueScale);
+        append(mFloatValues, stored, n);
+        break;
+      }
+      case sfUInt16:
+      {
+        quint16 stored[batchSize];
+        for (int i=0; i<n; ++i)
+        {
+          const double code = std::round((values[i]-mValueOffset)/mValueScale);
+          stored[i] = !(code > 0) ? quint16(0) : code >= 65535 ? quint16(65535) : quint16(code); // NaN goes to 0
+        }
+        append(mCodes, stored, n);
+        break;
+      }
+    }
+    values += n;
+    count -= n;
+  }
+}
+
+/*! \overload
+
+  Appends the provided \a values.
+*/
+void QCPUniformDataContainer::add(const QVector<double> &values)
+{
+  add(values.constData(), values.size());
+}
+
+/*! \overload
+
+  Appends a single \a value.
+*/
+void QCPUniformDataContainer::add(double value)
+{
+  add(&value, 1);
+}
+
+/*!
+  Appends \a count stored numbers from \a values as they are, without converting them. If the
+  storage format is not \ref sfFloat, each is converted as if added with its scaled value.
+*/
+void QCPUniformDataContainer::addRaw(const float *values, int count)
+{
+  if (count <= 0)
+    return;
+  if (mFormat == sfFloat)
+  {
+    append(mFloatValues, values, count);
+  } else
+  {
+    for (int i=0; i<count; ++i)
+    {
+      const double value = mValueOffset+mValueScale*values[i];
+      add(&value, 1);
+    }
+  }
+}
+
+/*! \overload
+
+  Appends \a count codes from \a codes as they are, without converting them. If the storage format
+  is not \ref sfUInt16, each is converted as if added with its scaled value.
+*/
+void QCPUniformDataContainer::addRaw(const quint16 *codes, int count)
+{
+  if (count <= 0)
+    return;
+  if (mFormat == sfUInt16)
+  {
+    append(mCodes, codes, count);
+  } else
+  {
+    for (int i=0; i<count; ++i)
+    {
+      const double value = mValueOffset+mValueScale*codes[i];
+      add(&value, 1);
+    }
+  }
+}
+
+/*!
+  Removes the first \a count data points. The remaining data points keep their keys (\ref
+  firstIndex advances). With a capacity this is O(1), otherwise the remaining values are moved.
+*/
+void QCPUniformDataContainer::removeFirst(int count)
+{
+  count = qBound(0, count, mCount);
+  if (count == 0)
+    return;
+  switch (mFormat)
+  {
+    case sfDouble: dropFront(mValues, count); break;
+    case sfFloat: dropFront(mFloatValues, count); break;
+    case sfUInt16: dropFront(mCodes, count); break;
+  }
+}
+
+/*!
+  Removes all data points. The key sampling and capacity are kept, and the next data point gets
+  the key offset again.
+*/
+void QCPUniformDataContainer::clear()
+{
+  resetStorage();
+}
+
+/*!
+  Frees the memory reserved beyond the current number of values. Does nothing with a capacity,
+  whose storage is allocated once.
+*/
+void QCPUniformDataContainer::squeeze()
+{
+  if (mCapacity > 0)
+    return;
+  mValues.squeeze();
+  mFloatValues.squeeze();
+  mCodes.squeeze();
+}
+
+/*!
+  Returns the index of the data point with a key that is equal to, just below, or just above \a
+  key, with the same semantics as \ref QCPDataContainer::findBegin. If the container is empty,
+  returns 0 (which is equal to \ref size).
+
+  Since the keys are implicit, this is computed directly instead of searched.
+*/
+int QCPUniformDataContainer::findBegin(double key, bool expandedRange) const
+{
+  int index = indexAtOrAbove(key);
+  if (expandedRange && index > 0)
+    --index;
+  return index;
+}
+
+/*!
+  Returns the index after the data point with a key that is equal to, just above or just below \a
+  key, with the same semantics as \ref QCPDataContainer::findEnd.
+
+  Since the keys are implicit, this is computed directly instead of searched.
+*/
+int QCPUniformDataContainer::findEnd(double key, bool expandedRange) const
+{
+  int index = indexAbove(key);
+  if (expandedRange && index < size())
+    ++index;
+  return index;
+}
+
+/*!
+  Returns the range encompassed by the keys of all data points with a non-NaN value, see \ref
+  QCPDataContainer::keyRange. Since the keys are ordered, only the NaN values at the ends are
+  visited.
+*/
+QCPRange QCPUniformDataContainer::keyRange(bool &foundRange, QCP::SignDomain signDomain) const
+{
+  int first = 0;
+  int last = size()-1;
+  if (signDomain == QCP::sdNegative)
+    last = indexAtOrAbove(0)-1;
+  else if (signDomain == QCP::sdPositive)
+    first = indexAbove(0);
+  while (first <= last && qIsNaN(value(first)))
+    ++first;
+  while (last >= first && qIsNaN(value(last)))
+    --last;
+  foundRange = first <= last;
+  if (!foundRange)
+    return QCPRange();
+  return QCPRange(key(first), key(last));
+}
+
+/*!
+  Returns the range encompassed by the values of the data points in the key range \a inKeyRange,
+  see \ref QCPDataContainer::valueRange. Inf and -Inf values are ignored.
+*/
+QCPRange QCPUniformDataContainer::valueRange(bool &foundRange, QCP::SignDomain signDomain, const QCPRange &inKeyRange) const
+{
+  QCPRange range;
+  bool haveLower = false;
+  bool haveUpper = false;
+  int begin = 0;
+  int end = size();
+  if (inKeyRange != QCPRange())
+  {
+    begin = findBegin(inKeyRange.lower, false);
+    end = findEnd(inKeyRange.upper, false);
+  }
+  for (int i=begin; i<end; ++i)
+  {
+    const double current = value(i);
+    if (!std::isfinite(current)) // also skips NaN
+      continue;
+    if ((signDomain == QCP::sdNegative && current >= 0) || (signDomain == QCP::sdPositive && current <= 0))
+      continue;
+    if (current < range.lower || !haveLower)
+    {
+      range.lower = current;
+      haveLower = true;
+    }
+    if (current > range.upper || !haveUpper)
+    {
+      range.upper = current;
+      haveUpper = true;
+    }
+  }
+  foundRange = haveLower && haveUpper;
+  return range;
+}
+
+/*!
+  Widens \a minValue and \a maxValue to include the values of the data points from \a begin up to
+  (not including) \a end. NaN values are ignored, and if \a minValue and \a maxValue are NaN they
+  stay NaN, exactly like a plain <tt>v < minValue</tt>/<tt>v > maxValue</tt> loop over the values.
+
+  If the level of detail index is enabled (\ref setLevelOfDetail), aligned runs of values are
+  covered by its precomputed buckets instead of being visited. The buckets hold stored numbers;
+  since the value scale is monotonic, scaling a bucket's extremes gives the extremes of its values.
+*/
+void QCPUniformDataContainer::expandValueSpan(int begin, int end, double &minValue, double &maxValue) const
+{
+  const QCPDataLevelOfDetail *lod = levelOfDetailIndex();
+  const int maxLevel = lod ? QCPDataLevelOfDetail::MinLevel+lod->levelCount()-1 : 0;
+  int i = begin;
+  while (i < end)
+  {
+    // find the coarsest bucket that starts at i and ends within the span:
+    int level = 0;
+    for (int l=QCPDataLevelOfDetail::MinLevel; l<=maxLevel; ++l)
+    {
+      if ((i & ((1 << l)-1)) != 0 || end-i < (1 << l) || (i >> l) >= lod->bucketCount(l))
+        break;
+      level = l;
+    }
+    if (level > 0)
+    {
+      const QCPDataLevelOfDetail::Bucket &b = lod->bucket(level, i >> level);
+      double low = mValueOffset+mValueScale*b.min;
+      double high = mValueOffset+mValueScale*b.max;
+      if (mValueScale < 0)
+        qSwap(low, high);
+      if (low < minValue)
+        minValue = low;
+      if (high > maxValue)
+        maxValue = high;
+      i += 1 << level;
+    } else
+    {
+      const double v = value(i);
+      if (v < minValue)
+        minValue = v;
+      else if (v > maxValue)
+        maxValue = v;
+      ++i;
+    }
+  }
+}
+
+/*! \internal
+
+  Returns the index of the first data point whose key is not below \a key, like \c std::lower_bound
+  on a sorted container.
+*/
+int QCPUniformDataContainer::indexAtOrAbove(double key) const
+{
+  const int n = size();
+  const double position = (key-mKeyOffset)/mKeyStep-double(mFirstIndex);
+  int index;
+  if (!(position > 0)) // also catches NaN, which compares like std::lower_bound does
+    index = 0;
+  else if (position >= n)
+    index = n;
+  else
+    index = int(std::ceil(position));
+  // the division may be off by an ulp, so settle on the same comparison the sorted containers use:
+  while (index > 0 && this->key(index-1) >= key)
+    --index;
+  while (index < n && this->key(index) < key)
+    ++index;
+  return index;
+}
+
+/*! \internal
+
+  Returns the index of the first data point whose key is above \a key, like \c std::upper_bound on
+  a sorted container.
+*/
+int QCPUniformDataContainer::indexAbove(double key) const
+{
+  const int n = size();
+  const double position = (key-mKeyOffset)/mKeyStep-double(mFirstIndex);
+  int index;
+  if (qIsNaN(position) || position >= n)
+    index = n;
+  else if (position < 0)
+    index = 0;
+  else
+    index = qMin(n, int(std::floor(position))+1);
+  while (index > 0 && this->key(index-1) > key)
+    --index;
+  while (index < n && this->key(index) <= key)
+    ++index;
+  return index;
+}
+
+/*! \internal
+
+  Returns the level of detail index brought up to date with the stored numbers, or nullptr if it is
+  disabled.
+*/
+const QCPDataLevelOfDetail *QCPUniformDataContainer::levelOfDetailIndex() const
+{
+  if (!mLevelOfDetail || mCapacity > 0)
+    return nullptr;
+  switch (mFormat)
+  {
+    case sfDouble: mLod.update(mValues.constData(), mCount); break;
+    case sfFloat: mLod.update(mFloatValues.constData(), mCount); break;
+    case sfUInt16: mLod.update(mCodes.constData(), mCount); break;
+  }
+  return &mLod;
+}
+
+/*! \internal
+
+  Removes all data points and prepares the storage of the current format: empty without a
+  capacity, or allocated once at twice the capacity for the ring.
+*/
+void QCPUniformDataContainer::resetStorage()
+{
+  mValues.clear();
+  mFloatValues.clear();
+  mCodes.clear();
+  if (mCapacity > 0)
+  {
+    switch (mFormat)
+    {
+      case sfDouble: mValues.resize(2*mCapacity); break;
+      case sfFloat: mFloatValues.resize(2*mCapacity); break;
+      case sfUInt16: mCodes.resize(2*mCapacity); break;
+    }
+  }
+  mHead = 0;
+  mCount = 0;
+  mFirstIndex = 0;
+  mLod.invalidate();
+}
+
+/*! \internal
+
+  Appends \a count stored numbers to \a storage, the vector of the current format. Without a
+  capacity the vector grows geometrically. With a capacity, each number is written at its ring
+  position and its mirror one capacity further, and the oldest data points are evicted once the
+  ring is full.
+*/
+template <class T>
+void QCPUniformDataContainer::append(QVector<T> &storage, const T *stored, int count)
+{
+  if (count <= 0)
+    return;
+  if (mCapacity == 0)
+  {
+    if (storage.capacity() < mCount+count) // grow geometrically so appending stays amortized O(1)
+      storage.reserve(qMax(mCount+count, 2*storage.capacity()));
+    storage.resize(mCount+count);
+    std::copy(stored, stored+count, storage.begin()+mCount);
+    mCount += count;
+    return;
+  }
+  if (count >= mCapacity) // only the newest capacity numbers survive, all old data points are evicted
+  {
+    const int skipped = count-mCapacity;
+    dropFront(storage, mCount);
+    mFirstIndex += skipped;
+    stored += skipped;
+    count = mCapacity;
+  }
+  T *data = storage.data();
+  while (count > 0)
+  {
+    int position = mHead+mCount;
+    if (position >= mCapacity)
+      position -= mCapacity;
+    const int run = qMin(count, mCapacity-position); // contiguous up to the end of the ring
+    std::copy(stored, stored+run, data+position);
+    std::copy(stored, stored+run, data+position+mCapacity);
+    const int overflow = qMax(0, mCount+run-mCapacity);
+    mCount += run-overflow;
+    mHead += overflow;
+    if (mHead >= mCapacity)
+      mHead -= mCapacity;
+    mFirstIndex += overflow;
+    stored += run;
+    count -= run;
+  }
+}
+
+/*! \internal
+
+  Removes the first \a count (at most \ref size) data points from \a storage, the vector of the
+  current format.
+*/
+template <class T>
+void QCPUniformDataContainer::dropFront(QVector<T> &storage, int count)
+{
+  if (count <= 0)
+    return;
+  if (mCapacity == 0)
+  {
+    storage.remove(0, count);
+    mLod.invalidate();
+  } else
+  {
+    mHead += count;
+    if (mHead >= mCapacity)
+      mHead -= mCapacity;
+  }
+  mCount -= count;
+  mFirstIndex += count;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//////////////////// QCPUniformGraph
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*! \class QCPUniformGraph
+  \brief A graph of uniformly sampled data, storing values only
+
+  The key of each data point is implicit, <tt>keyOffset + index*keyStep</tt> as set on the \ref
+  QCPUniformDataContainer returned by \ref data. This suits data sampled at a fixed rate, where a
+  \ref QCPGraph would store a key next to every value and binary search for the visible range.
+
+  Line drawing with adaptive sampling, scatter drawing with scatter skip and adaptive sampling, and
+  point and rect selection behave like those of \ref QCPGraph with the line styles \ref
+  QCPGraph::lsNone and \ref QCPGraph::lsLine. Fills (\ref setBrush) are not drawn.
+
+  Unlike graphs, uniform graphs aren't created with QCustomPlot::addGraph. Create them with \c new,
+  passing the key and value axes; the plot takes ownership.
+*/
+
+/* start of documentation of inline functions */
+
+/*! \fn QSharedPointer<QCPUniformDataContainer> QCPUniformGraph::data() const
+
+  Returns a shared pointer to the internal data storage. Use it to append values or change the key
+  sampling directly.
+*/
+
+/* end of documentation of inline functions */
+
+/*!
+  Constructs a uniform graph which uses \a keyAxis as its key axis ("x") and \a valueAxis as its
+  value axis ("y"). \a keyAxis and \a valueAxis must reside in the same QCustomPlot instance and not
+  have the same orientation.
+
+  The created QCPUniformGraph is automatically registered with the QCustomPlot instance inferred
+  from \a keyAxis. This QCustomPlot instance takes ownership of the QCPUniformGraph, so do not
+  delete it manually but use QCustomPlot::removePlottable() instead.
+*/
+QCPUniformGraph::QCPUniformGraph(QCPAxis *keyAxis, QCPAxis *valueAxis) :
+  QCPAbstractPlottable(keyAxis, valueAxis),
+  mDataContainer(new QCPUniformDataContainer),
+  mLineStyle{},
+  mScatterSkip{},
+  mAdaptiveSampling{}
+{
+  setPen(QPen(Qt::blue, 0));
+  setBrush(Qt::NoBrush);
+  
+  setLineStyle(lsLine);
+  setScatterSkip(0);
+  setAdaptiveSampling(true);
+}
+
+QCPUniformGraph::~QCPUniformGraph()
+{
+}
+
+/*! \overload
+
+  Replaces the current data container with the provided \a data container. Multiple uniform graphs
+  may share the same container.
+*/
+void QCPUniformGraph::setData(QSharedPointer<QCPUniformDataContainer> data)
+{
+  mDataContainer = data;
+}
+
+/*! \overload
+
+  Replaces the current data with \a values, the first at key \a keyOffset and each following one
+  \a keyStep further.
+*/
+void QCPUniformGraph::setData(double keyOffset, double keyStep, const QVector<double> &values)
+{
+  mDataContainer->setKeySampling(keyOffset, keyStep);
+  mDataContainer->set(values);
+}
+
+/*!
+  Sets how the single data points are connected in the plot.
+
+  \see setScatterStyle
+*/
+void QCPUniformGraph::setLineStyle(LineStyle ls)
+{
+  mLineStyle = ls;
+}
+
+/*!
+  Sets the visual appearance of single data points in the plot. If set to \ref
+  QCPScatterStyle::ssNone, no scatter points are drawn.
+
+  \see setLineStyle
+*/
+void QCPUniformGraph::setScatterStyle(const QCPScatterStyle &style)
+{
+  mScatterStyle = style;
+}
+
+/*!
+  If scatters are displayed, \a skip number of scatter points are skipped after every drawn
+  scatter point, see \ref QCPGraph::setScatterSkip.
+*/
+void QCPUniformGraph::setScatterSkip(int skip)
+{
+  mScatterSkip = qMax(0, skip);
+}
+
+/*!
+  Sets whether adaptive sampling shall be used when plotting this graph, see \ref
+  QCPGraph::setAdaptiveSampling. Enabled by default.
+*/
+void QCPUniformGraph::setAdaptiveSampling(bool enabled)
+{
+  mAdaptiveSampling = enabled;
+}
+
+/*! \overload
+
+  Appends \a values after the current data.
+*/
+void QCPUniformGraph::addData(const QVector<double> &values)
+{
+  mDataContainer->add(values);
+}
+
+/*! \overload
+
+  Appends a single \a value after the current data.
+*/
+void QCPUniformGraph::addData(double value)
+{
+  mDataContainer->add(value);
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::dataCount
+*/
+int QCPUniformGraph::dataCount() const
+{
+  return mDataContainer->size();
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::dataMainKey
+*/
+double QCPUniformGraph::dataMainKey(int index) const
+{
+  if (index >= 0 && index < mDataContainer->size())
+  {
+    return mDataContainer->key(index);
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return 0;
+  }
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::dataSortKey
+*/
+double QCPUniformGraph::dataSortKey(int index) const
+{
+  return dataMainKey(index);
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::dataMainValue
+*/
+double QCPUniformGraph::dataMainValue(int index) const
+{
+  if (index >= 0 && index < mDataContainer->size())
+  {
+    return mDataContainer->value(index);
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return 0;
+  }
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::dataValueRange
+*/
+QCPRange QCPUniformGraph::dataValueRange(int index) const
+{
+  if (index >= 0 && index < mDataContainer->size())
+  {
+    const double value = mDataContainer->value(index);
+    return QCPRange(value, value);
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return QCPRange(0, 0);
+  }
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::dataPixelPosition
+*/
+QPointF QCPUniformGraph::dataPixelPosition(int index) const
+{
+  if (index >= 0 && index < mDataContainer->size())
+  {
+    return coordsToPixels(mDataContainer->key(index), mDataContainer->value(index));
+  } else
+  {
+    qDebug() << Q_FUNC_INFO << "Index out of bounds" << index;
+    return QPointF();
+  }
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::sortKeyIsMainKey
+*/
+bool QCPUniformGraph::sortKeyIsMainKey() const
+{
+  return true;
+}
+
+/*!
+  Implements a rect-selection algorithm like \ref QCPAbstractPlottable1D::selectTestRect. The keys
+  inside the rect are found arithmetically.
+
+  \seebaseclassmethod
+*/
+QCPDataSelection QCPUniformGraph::selectTestRect(const QRectF &rect, bool onlySelectable) const
+{
+  QCPDataSelection result;
+  if ((onlySelectable && mSelectable == QCP::stNone) || mDataContainer->isEmpty())
+    return result;
+  if (!mKeyAxis || !mValueAxis)
+    return result;
+  
+  // convert rect given in pixels to ranges given in plot coordinates:
+  double key1, value1, key2, value2;
+  pixelsToCoords(rect.topLeft(), key1, value1);
+  pixelsToCoords(rect.bottomRight(), key2, value2);
+  QCPRange keyRange(key1, key2); // QCPRange normalizes internally so we don't have to care about whether key1 < key2
+  QCPRange valueRange(value1, value2);
+  const int begin = mDataContainer->findBegin(keyRange.lower, false);
+  const int end = mDataContainer->findEnd(keyRange.upper, false);
+  if (begin == end)
+    return result;
+  
+  int currentSegmentBegin = -1; // -1 means we're currently not in a segment that's contained in rect
+  for (int i=begin; i<end; ++i)
+  {
+    const bool contained = valueRange.contains(mDataContainer->value(i)) && keyRange.contains(mDataContainer->key(i));
+    if (currentSegmentBegin == -1)
+    {
+      if (contained) // start segment
+        currentSegmentBegin = i;
+    } else if (!contained) // segment just ended
+    {
+      result.addDataRange(QCPDataRange(currentSegmentBegin, i), false);
+      currentSegmentBegin = -1;
+    }
+  }
+  // process potential last segment:
+  if (currentSegmentBegin != -1)
+    result.addDataRange(QCPDataRange(currentSegmentBegin, end), false);
+  
+  result.simplify();
+  return result;
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::findBegin
+*/
+int QCPUniformGraph::findBegin(double sortKey, bool expandedRange) const
+{
+  return mDataContainer->findBegin(sortKey, expandedRange);
+}
+
+/*!
+  \copydoc QCPPlottableInterface1D::findEnd
+*/
+int QCPUniformGraph::findEnd(double sortKey, bool expandedRange) const
+{
+  return mDataContainer->findEnd(sortKey, expandedRange);
+}
+
+/*!
+  Implements a selectTest specific to this plottable's point geometry, like \ref
+  QCPGraph::selectTest.
+
+  If \a details is not 0, it will be set to a \ref QCPDataSelection, describing the closest data
+  point to \a pos.
+
+  \seebaseclassmethod \ref QCPAbstractPlottable::selectTest
+*/
+double QCPUniformGraph::selectTest(const QPointF &pos, bool onlySelectable, QVariant *details) const
+{
+  if ((onlySelectable && mSelectable == QCP::stNone) || mDataContainer->isEmpty())
+    return -1;
+  if (!mKeyAxis || !mValueAxis)
+    return -1;
+  
+  if (mKeyAxis.data()->axisRect()->rect().contains(pos.toPoint()) || mParentPlot->interactions().testFlag(QCP::iSelectPlottablesBeyondAxisRect))
+  {
+    int closestDataPoint = mDataContainer->size();
+    double result = pointDistance(pos, closestDataPoint);
+    if (details)
+      details->setValue(QCPDataSelection(QCPDataRange(closestDataPoint, closestDataPoint+1)));
+    return result;
+  } else
+    return -1;
+}
+
+/* inherits documentation from base class */
+QCPRange QCPUniformGraph::getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain) const
+{
+  return mDataContainer->keyRange(foundRange, inSignDomain);
+}
+
+/* inherits documentation from base class */
+QCPRange QCPUniformGraph::getValueRange(bool &foundRange, QCP::SignDomain inSignDomain, const QCPRange &inKeyRange) const
+{
+  return mDataContainer->valueRange(foundRange, inSignDomain, inKeyRange);
+}
+
+/* inherits documentation from base class */
+void QCPUniformGraph::draw(QCPPainter *painter)
+{
+  if (!mKeyAxis || !mValueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+  if (mKeyAxis.data()->range().size() <= 0 || mDataContainer->isEmpty()) return;
+  if (mLineStyle == lsNone && mScatterStyle.isNone()) return;
+  
+  QVector<QPointF> lines, scatters; // line and (if necessary) scatter pixel coordinates will be stored here while iterating over segments
+  
+  // loop over and draw segments of unselected/selected data:
+  QList<QCPDataRange> selectedSegments, unselectedSegments, allSegments;
+  getDataSegments(selectedSegments, unselectedSegments);
+  allSegments << unselectedSegments << selectedSegments;
+  for (int i=0; i<allSegments.size(); ++i)
+  {
+    bool isSelectedSegment = i >= unselectedSegments.size();
+    
+#ifdef QCUSTOMPLOT_CHECK_DATA
+    for (int d=0; d<mDataContainer->size(); ++d)
+    {
+      if (QCP::isInvalidData(mDataContainer->value(d)))
+        qDebug() << Q_FUNC_INFO << "Data point at" << mDataContainer->key(d) << "invalid." << "Plottable name:" << name();
+    }
+#endif
+    
+    // draw line:
+    if (mLineStyle != lsNone)
+    {
+      QCPDataRange lineDataRange = isSelectedSegment ? allSegments.at(i) : allSegments.at(i).adjusted(-1, 1); // unselected segments extend lines to bordering selected data point (safe to exceed total data bounds in first/last segment, getLines takes care)
+      getLines(&lines, lineDataRange);
+      if (isSelectedSegment && mSelectionDecorator)
+        mSelectionDecorator->applyPen(painter);
+      else
+        painter->setPen(mPen);
+      painter->setBrush(Qt::NoBrush);
+      drawLinePlot(painter, lines);
+    }
+    
+    // draw scatters:
+    QCPScatterStyle finalScatterStyle = mScatterStyle;
+    if (isSelectedSegment && mSelectionDecorator)
+      finalScatterStyle = mSelectionDecorator->getFinalScatterStyle(mScatterStyle);
+    if (!finalScatterStyle.isNone())
+    {
+      getScatters(&scatters, allSegments.at(i));
+      drawScatterPlot(painter, scatters, finalScatterStyle);
+    }
+  }
+  
+  // draw other selection decoration that isn't just line/scatter pens and brushes:
+  if (mSelectionDecorator)
+    mSelectionDecorator->drawDecoration(painter, selection());
+}
+
+/* inherits documentation from base class */
+void QCPUniformGraph::drawLegendIcon(QCPPainter *painter, const QRectF &rect) const
+{
+  // draw line vertically centered:
+  if (mLineStyle != lsNone)
+  {
+    applyDefaultAntialiasingHint(painter);
+    painter->setPen(mPen);
+    painter->drawLine(QLineF(rect.left(), rect.top()+rect.height()/2.0, rect.right()+5, rect.top()+rect.height()/2.0)); // +5 on x2 else last segment is missing from dashed/dotted pens
+  }
+  // draw scatter symbol:
+  if (!mScatterStyle.isNone())
+  {
+    applyScattersAntialiasingHint(painter);
+    // scale scatter pixmap if it's too large to fit in legend icon rect:
+    if (mScatterStyle.shape() == QCPScatterStyle::ssPixmap && (mScatterStyle.pixmap().size().width() > rect.width() || mScatterStyle.pixmap().size().height() > rect.height()))
+    {
+      QCPScatterStyle scaledStyle(mScatterStyle);
+      scaledStyle.setPixmap(scaledStyle.pixmap().scaled(rect.size().toSize(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
+      scaledStyle.applyTo(painter, mPen);
+      scaledStyle.drawShape(painter, QRectF(rect).center());
+    } else
+    {
+      mScatterStyle.applyTo(painter, mPen);
+      mScatterStyle.drawShape(painter, QRectF(rect).center());
+    }
+  }
+}
+
+/*! \internal
+
+  Draws scatter symbols at every point passed in \a scatters, given in pixel coordinates, with the
+  appearance specified in \a style.
+*/
+void QCPUniformGraph::drawScatterPlot(QCPPainter *painter, const QVector<QPointF> &scatters, const QCPScatterStyle &style) const
+{
+  applyScattersAntialiasingHint(painter);
+  style.applyTo(painter, mPen);
+  foreach (const QPointF &scatter, scatters)
+    style.drawShape(painter, scatter.x(), scatter.y());
+}
+
+/*! \internal
+
+  Draws lines between the points in \a lines, given in pixel coordinates.
+*/
+void QCPUniformGraph::drawLinePlot(QCPPainter *painter, const QVector<QPointF> &lines) const
+{
+  if (painter->pen().style() != Qt::NoPen && painter->pen().color().alpha() != 0)
+  {
+    applyDefaultAntialiasingHint(painter);
+    drawPolyline(painter, lines);
+  }
+}
+
+/*! \internal
+
+  Returns via \a lineData the data points from \a begin up to (not including) \a end that need to
+  be visualized for the graph line, like \ref QCPGraph::getOptimizedLineData and with the same
+  output.
+
+  With adaptive sampling, the data points that fall on one key pixel form an index interval whose
+  end is computed directly from the key sampling, and its value span comes from \ref
+  QCPUniformDataContainer::expandValueSpan. So keys are only computed once per pixel, and with the
+  container's level of detail index enabled, the work is proportional to the number of pixels.
+*/
+void QCPUniformGraph::getOptimizedLineData(QVector<QCPGraphData> *lineData, int begin, int end) const
+{
+  if (!lineData) return;
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+  if (begin == end) return;
+  const QCPUniformDataContainer &data = *mDataContainer;
+  
+  int dataCount = end-begin;
+  int maxCount = (std::numeric_limits<int>::max)();
+  if (mAdaptiveSampling)
+  {
+    double keyPixelSpan = qAbs(keyAxis->coordToPixel(data.key(begin))-keyAxis->coordToPixel(data.key(end-1)));
+    if (2*keyPixelSpan+2 < static_cast<double>((std::numeric_limits<int>::max)()))
+      maxCount = int(2*keyPixelSpan+2);
+  }
+  
+  if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
+  {
+    int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
+    int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
+    double currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(data.key(begin))+reversedRound));
+    double lastIntervalEndKey = currentIntervalStartKey;
+    double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
+    bool keyEpsilonVariable = keyAxis->scaleType() == QCPAxis::stLogarithmic; // indicates whether keyEpsilon needs to be updated after every interval (for log axes)
+    int intervalBegin = begin;
+    while (true)
+    {
+      // the interval holds its first data point and all following ones with a key inside the pixel:
+      const int intervalEnd = qBound(intervalBegin+1, data.findBegin(currentIntervalStartKey+keyEpsilon, false), end);
+      double minValue = data.value(intervalBegin);
+      double maxValue = minValue;
+      data.expandValueSpan(intervalBegin+1, intervalEnd, minValue, maxValue);
+      const int intervalDataCount = intervalEnd-intervalBegin;
+      if (intervalEnd == end) // handle last interval:
+      {
+        if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+        {
+          if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point wasn't a cluster, so first point of this cluster must be at a real data point
+            lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, data.value(intervalBegin)));
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+        } else
+          lineData->append(QCPGraphData(data.key(intervalBegin), data.value(intervalBegin)));
+        break;
+      }
+      if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them to a cluster
+      {
+        if (lastIntervalEndKey < currentIntervalStartKey-keyEpsilon) // last point is further away, so first point of this cluster must be at a real data point
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.2, data.value(intervalBegin)));
+        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.25, minValue));
+        lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.75, maxValue));
+        if (data.key(intervalEnd) > currentIntervalStartKey+keyEpsilon*2) // new pixel started further away from previous cluster, so make sure the last point of the cluster is at a real data point
+          lineData->append(QCPGraphData(currentIntervalStartKey+keyEpsilon*0.8, data.value(intervalEnd-1)));
+      } else
+        lineData->append(QCPGraphData(data.key(intervalBegin), data.value(intervalBegin)));
+      lastIntervalEndKey = data.key(intervalEnd-1);
+      intervalBegin = intervalEnd;
+      currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(data.key(intervalBegin))+reversedRound));
+      if (keyEpsilonVariable)
+        keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
+    }
+    
+  } else // don't use adaptive sampling algorithm, transfer points one-to-one from the data container into the output
+  {
+    lineData->resize(dataCount);
+    for (int i=0; i<dataCount; ++i)
+      (*lineData)[i] = QCPGraphData(data.key(begin+i), data.value(begin+i));
+  }
+}
+
+/*! \internal
+
+  Returns via \a scatterData the data points from \a begin up to (not including) \a end that need
+  to be visualized for this graph when plotting scatter points, taking \ref setScatterSkip and
+  adaptive sampling into account like \ref QCPGraph::getOptimizedScatterData.
+*/
+void QCPUniformGraph::getOptimizedScatterData(QVector<QCPGraphData> *scatterData, int begin, int end) const
+{
+  if (!scatterData) return;
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+  const QCPUniformDataContainer &data = *mDataContainer;
+  
+  const int scatterModulo = mScatterSkip+1;
+  const bool doScatterSkip = mScatterSkip > 0;
+  while (doScatterSkip && begin != end && begin % scatterModulo != 0) // advance begin to first non-skipped scatter
+    ++begin;
+  if (begin == end) return;
+  int dataCount = end-begin;
+  int maxCount = (std::numeric_limits<int>::max)();
+  if (mAdaptiveSampling)
+  {
+    int keyPixelSpan = int(qAbs(keyAxis->coordToPixel(data.key(begin))-keyAxis->coordToPixel(data.key(end-1))));
+    maxCount = 2*keyPixelSpan+2;
+  }
+  
+  if (mAdaptiveSampling && dataCount >= maxCount) // use adaptive sampling only if there are at least two points per pixel on average
+  {
+    const double valueMaxRange = valueAxis->range().upper;
+    const double valueMinRange = valueAxis->range().lower;
+    int it = begin;
+    double minValue = data.value(it);
+    double maxValue = minValue;
+    int minValueIt = it;
+    int maxValueIt = it;
+    int currentIntervalStart = it;
+    int reversedFactor = keyAxis->pixelOrientation(); // is used to calculate keyEpsilon pixel into the correct direction
+    int reversedRound = reversedFactor==-1 ? 1 : 0; // is used to switch between floor (normal) and ceil (reversed) rounding of currentIntervalStartKey
+    double currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(data.key(begin))+reversedRound));
+    double keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor)); // interval of one pixel on screen when mapped to plot key coordinates
+    bool keyEpsilonVariable = keyAxis->scaleType() == QCPAxis::stLogarithmic; // indicates whether keyEpsilon needs to be updated after every interval (for log axes)
+    int intervalDataCount = 1;
+    
+    // outputs the points of the interval [currentIntervalStart, it), thinned out to keep a certain vertical density:
+    auto appendInterval = [&]()
+    {
+      if (intervalDataCount >= 2) // last pixel had multiple data points, consolidate them
+      {
+        // determine value pixel span and add as many points in interval to maintain certain vertical data density (this is specific to scatter plot):
+        double valuePixelSpan = qAbs(valueAxis->coordToPixel(minValue)-valueAxis->coordToPixel(maxValue));
+        int dataModulo = qMax(1, qRound(intervalDataCount/(valuePixelSpan/4.0))); // approximately every 4 value pixels one data point on average
+        int c = 0;
+        for (int intervalIt=currentIntervalStart; intervalIt<it; intervalIt+=scatterModulo)
+        {
+          const double value = data.value(intervalIt);
+          if ((c % dataModulo == 0 || intervalIt == minValueIt || intervalIt == maxValueIt) && value > valueMinRange && value < valueMaxRange)
+            scatterData->append(QCPGraphData(data.key(intervalIt), value));
+          ++c;
+        }
+      } else if (data.value(currentIntervalStart) > valueMinRange && data.value(currentIntervalStart) < valueMaxRange)
+        scatterData->append(QCPGraphData(data.key(currentIntervalStart), data.value(currentIntervalStart)));
+    };
+    
+    // advance to second (non-skipped) data point because adaptive sampling works in 1 point retrospect:
+    it = qMin(it+scatterModulo, end);
+    // main loop over data points:
+    while (it != end)
+    {
+      const double value = data.value(it);
+      if (data.key(it) < currentIntervalStartKey+keyEpsilon) // data point is still within same pixel, so skip it and expand value span of this pixel if necessary
+      {
+        if (value < minValue && value > valueMinRange && value < valueMaxRange)
+        {
+          minValue = value;
+          minValueIt = it;
+        } else if (value > maxValue && value > valueMinRange && value < valueMaxRange)
+        {
+          maxValue = value;
+          maxValueIt = it;
+        }
+        ++intervalDataCount;
+      } else // new pixel started
+      {
+        appendInterval();
+        minValue = value;
+        maxValue = value;
+        minValueIt = it;
+        maxValueIt = it;
+        currentIntervalStart = it;
+        currentIntervalStartKey = keyAxis->pixelToCoord(int(keyAxis->coordToPixel(data.key(it))+reversedRound));
+        if (keyEpsilonVariable)
+          keyEpsilon = qAbs(currentIntervalStartKey-keyAxis->pixelToCoord(keyAxis->coordToPixel(currentIntervalStartKey)+1.0*reversedFactor));
+        intervalDataCount = 1;
+      }
+      // advance to next data point:
+      it = qMin(it+scatterModulo, end);
+    }
+    // handle last interval:
+    appendInterval();
+    
+  } else // don't use adaptive sampling algorithm, transfer points one-to-one from the data container into the output
+  {
+    scatterData->reserve(dataCount/scatterModulo+1);
+    for (int it=begin; it<end; it+=scatterModulo)
+      scatterData->append(QCPGraphData(data.key(it), data.value(it)));
+  }
+}
+
+/*! \internal
+
+  Splits all data into selected and unselected segments, like \ref
+  QCPAbstractPlottable1D::getDataSegments.
+*/
+void QCPUniformGraph::getDataSegments(QList<QCPDataRange> &selectedSegments, QList<QCPDataRange> &unselectedSegments) const
+{
+  selectedSegments.clear();
+  unselectedSegments.clear();
+  if (mSelectable == QCP::stWhole) // stWhole selection type draws the entire plottable with selected style if mSelection isn't empty
+  {
+    if (selected())
+      selectedSegments << QCPDataRange(0, dataCount());
+    else
+      unselectedSegments << QCPDataRange(0, dataCount());
+  } else
+  {
+    QCPDataSelection sel(selection());
+    sel.simplify();
+    selectedSegments = sel.dataRanges();
+    unselectedSegments = sel.inverse(QCPDataRange(0, dataCount())).dataRanges();
+  }
+}
+
+/*! \internal
+
+  Outputs the index range of the currently visible data via \a begin and \a end, including the
+  data points just outside the key axis range, and never exceeding \a rangeRestriction. Computed
+  directly from the key sampling.
+*/
+void QCPUniformGraph::getVisibleDataBounds(int &begin, int &end, const QCPDataRange &rangeRestriction) const
+{
+  begin = end = mDataContainer->size();
+  if (rangeRestriction.isEmpty())
+    return;
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return; }
+  // get visible data range, limited to rangeRestriction:
+  QCPDataRange visible(mDataContainer->findBegin(keyAxis->range().lower), mDataContainer->findEnd(keyAxis->range().upper));
+  visible = visible.bounded(rangeRestriction.bounded(mDataContainer->dataRange()));
+  begin = visible.begin();
+  end = visible.end();
+}
+
+/*! \internal
+
+  Retrieves the optimized line data of the data points in \a dataRange via \ref
+  getOptimizedLineData and returns them in \a lines as pixel coordinates. \a dataRange may exceed
+  the data bounds. If the line style is \ref lsNone, \a lines will be empty.
+*/
+void QCPUniformGraph::getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const
+{
+  if (!lines) return;
+  int begin, end;
+  getVisibleDataBounds(begin, end, dataRange);
+  if (begin == end || mLineStyle == lsNone)
+  {
+    lines->clear();
+    return;
+  }
+  
+  QVector<QCPGraphData> lineData;
+  getOptimizedLineData(&lineData, begin, end);
+  
+  if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in lineData (significantly simplifies following processing)
+    std::reverse(lineData.begin(), lineData.end());
+  *lines = dataToPixels(lineData);
+}
+
+/*! \internal
+
+  Retrieves the optimized scatter data of the data points in \a dataRange via \ref
+  getOptimizedScatterData and returns them in \a scatters as pixel coordinates. \a dataRange may
+  exceed the data bounds. Data points with NaN values are left out.
+*/
+void QCPUniformGraph::getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const
+{
+  if (!scatters) return;
+  int begin, end;
+  getVisibleDataBounds(begin, end, dataRange);
+  if (begin == end)
+  {
+    scatters->clear();
+    return;
+  }
+  
+  QVector<QCPGraphData> data;
+  getOptimizedScatterData(&data, begin, end);
+  data.erase(std::remove_if(data.begin(), data.end(), [](const QCPGraphData &point) { return qIsNaN(point.value); }), data.end());
+  
+  if (mKeyAxis->rangeReversed() != (mKeyAxis->orientation() == Qt::Vertical)) // make sure key pixels are sorted ascending in data (significantly simplifies following processing)
+    std::reverse(data.begin(), data.end());
+  *scatters = dataToPixels(data);
+}
+
+/*! \internal
+
+  Converts the data points \a data given in plot coordinates to pixel coordinates.
+*/
+QVector<QPointF> QCPUniformGraph::dataToPixels(const QVector<QCPGraphData> &data) const
+{
+  QVector<QPointF> result;
+  QCPAxis *keyAxis = mKeyAxis.data();
+  QCPAxis *valueAxis = mValueAxis.data();
+  if (!keyAxis || !valueAxis) { qDebug() << Q_FUNC_INFO << "invalid key or value axis"; return result; }
+  
+  result.resize(data.size());
+  if (keyAxis->orientation() == Qt::Vertical)
+  {
+    for (int i=0; i<data.size(); ++i)
+    {
+      result[i].setX(valueAxis->coordToPixel(data.at(i).value));
+      result[i].setY(keyAxis->coordToPixel(data.at(i).key));
+    }
+  } else // key axis is horizontal
+  {
+    for (int i=0; i<data.size(); ++i)
+    {
+      result[i].setX(keyAxis->coordToPixel(data.at(i).key));
+      result[i].setY(valueAxis->coordToPixel(data.at(i).value));
+    }
+  }
+  return result;
+}
+
+/*! \internal
+
+  Draws the line through \a lineData with gaps at NaN points, like \ref
+  QCPAbstractPlottable1D::drawPolyline.
+*/
+void QCPUniformGraph::drawPolyline(QCPPainter *painter, const QVector<QPointF> &lineData) const
+{
+  // reduce 1px lines to cosmetic when not exporting, see QCPAbstractPlottable1D::drawPolyline:
+  if (!painter->modes().testFlag(QCPPainter::pmVectorized) &&
+      qFuzzyCompare(painter->pen().widthF(), 1.0))
+  {
+    QPen newPen = painter->pen();
+    newPen.setWidth(0);
+    painter->setPen(newPen);
+  }
+  
+  // if drawing solid line and not in PDF, use much faster line drawing instead of polyline:
+  if (mParentPlot->plottingHints().testFlag(QCP::phFastPolylines) &&
+      painter->pen().style() == Qt::SolidLine &&
+      !painter->modes().testFlag(QCPPainter::pmVectorized) &&
+      !painter->modes().testFlag(QCPPainter::pmNoCaching))
+  {
+    int i = 0;
+    bool lastIsNan = false;
+    const int lineDataSize = lineData.size();
+    while (i < lineDataSize && (qIsNaN(lineData.at(i).y()) || qIsNaN(lineData.at(i).x()))) // make sure first point is not NaN
+      ++i;
+    ++i; // because drawing works in 1 point retrospect
+    while (i < lineDataSize)
+    {
+      if (!qIsNaN(lineData.at(i).y()) && !qIsNaN(lineData.at(i).x())) // NaNs create a gap in the line
+      {
+        if (!lastIsNan)
+          painter->drawLine(lineData.at(i-1), lineData.at(i));
+        else
+          lastIsNan = false;
+      } else
+        lastIsNan = true;
+      ++i;
+    }
+  } else
+  {
+    int segmentStart = 0;
+    int i = 0;
+    const int lineDataSize = lineData.size();
+    while (i < lineDataSize)
+    {
+      if (qIsNaN(lineData.at(i).y()) || qIsNaN(lineData.at(i).x()) || qIsInf(lineData.at(i).y())) // NaNs create a gap in the line. Also filter Infs which make drawPolyline block
+      {
+        painter->drawPolyline(lineData.constData()+segmentStart, i-segmentStart); // i, because we don't want to include the current NaN point
+        segmentStart = i+1;
+      }
+      ++i;
+    }
+    // draw last segment:
+    painter->drawPolyline(lineData.constData()+segmentStart, lineDataSize-segmentStart);
+  }
+}
+
+/*! \internal
+
+  Returns the pixel distance of \a pixelPoint to the graph, like \ref QCPGraph::pointDistance. The
+  index of the closest data point is returned in \a closestData, or \ref
+  QCPUniformDataContainer::size if there is none.
+*/
+double QCPUniformGraph::pointDistance(const QPointF &pixelPoint, int &closestData) const
+{
+  closestData = mDataContainer->size();
+  if (mDataContainer->isEmpty())
+    return -1.0;
+  if (mLineStyle == lsNone && mScatterStyle.isNone())
+    return -1.0;
+  
+  // calculate minimum distances to graph data points and find closestData index:
+  double minDistSqr = (std::numeric_limits<double>::max)();
+  // determine which key range comes into question, taking selection tolerance around pos into account:
+  double posKeyMin, posKeyMax, dummy;
+  pixelsToCoords(pixelPoint-QPointF(mParentPlot->selectionTolerance(), mParentPlot->selectionTolerance()), posKeyMin, dummy);
+  pixelsToCoords(pixelPoint+QPointF(mParentPlot->selectionTolerance(), mParentPlot->selectionTolerance()), posKeyMax, dummy);
+  if (posKeyMin > posKeyMax)
+    qSwap(posKeyMin, posKeyMax);
+  // iterate over found data points and then choose the one with the shortest distance to pos:
+  const int begin = mDataContainer->findBegin(posKeyMin, true);
+  const int end = mDataContainer->findEnd(posKeyMax, true);
+  for (int i=begin; i<end; ++i)
+  {
+    const double currentDistSqr = QCPVector2D(coordsToPixels(mDataContainer->key(i), mDataContainer->value(i))-pixelPoint).lengthSquared();
+    if (currentDistSqr < minDistSqr)
+    {
+      minDistSqr = currentDistSqr;
+      closestData = i;
+    }
+  }
+  
+  // calculate distance to graph line if there is one (if so, will probably be smaller than distance to closest data point):
+  if (mLineStyle != lsNone)
+  {
+    QVector<QPointF> lineData;
+    getLines(&lineData, QCPDataRange(0, dataCount())); // don't limit data range further since with sharp data spikes, line segments may be closer to test point than segments with closer key coordinate
+    QCPVector2D p(pixelPoint);
+    for (int i=0; i<lineData.size()-1; ++i)
+    {
+      const double currentDistSqr = p.distanceSquaredToLine(lineData.at(i), lineData.at(i+1));
+      if (currentDistSqr < minDistSqr)
+        minDistSqr = currentDistSqr;
+    }
+  }
+  
+  return qSqrt(minDistSqr);
+}
+/* end of 'src/plottables/plottable-uniformgraph.cpp' */
+
+
 /* including file 'src/plottables/plottable-curve.cpp' */
 /* modified 2022-11-06T12:45:56, size 63851            */
 
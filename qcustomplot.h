@@ -51,12 +51,18 @@
 #include <QtCore/QPointer>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QTimer>
+#include <QtCore/QRunnable>
+#include <QtCore/QSemaphore>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtGui/QPainter>
 #include <QtGui/QPainterPath>
 #include <QtGui/QPaintEvent>
 #include <QtGui/QMouseEvent>
 #include <QtGui/QWheelEvent>
 #include <QtGui/QPixmap>
+#include <QtGui/QImage>
+#include <QtGui/QPicture>
 #include <QtCore/QVector>
 #include <QtCore/QString>
 #include <QtCore/QDateTime>
@@ -268,6 +274,8 @@ enum PlottingHint { phNone              = 0x000 ///< <tt>0x000</tt> No hints are
                     ,phImmediateRefresh = 0x002 ///< <tt>0x002</tt> causes an immediate repaint() instead of a soft update() when QCustomPlot::replot() is called with parameter \ref QCustomPlot::rpRefreshHint.
                                                 ///<                This is set by default to prevent the plot from freezing on fast consecutive replots (e.g. user drags ranges with mouse).
                     ,phCacheLabels      = 0x004 ///< <tt>0x004</tt> axis (tick) labels will be cached as pixmaps, increasing replot performance.
+                    ,phThreadedStreaming = 0x008 ///< <tt>0x008</tt> \ref QCustomPlot::replotStreaming records the streaming layer and rasterizes it on a worker thread,
+                                                ///<                so the GUI thread stays responsive while large graphs render (not with OpenGL).
                   };
 Q_DECLARE_FLAGS(PlottingHints, PlottingHint)
 
@@ -2609,6 +2617,106 @@ Q_DECLARE_METATYPE(QCPScatterStyle::ScatterShape)
 template <class DataType>
 inline bool qcpLessThanSortKey(const DataType &a, const DataType &b) { return a.sortKey() < b.sortKey(); }
 
+class QCPDataLevelOfDetail // header-only, filled from a QCPDataContainer through the template update method
+{
+public:
+  /*!
+    Minimum and maximum main value of one bucket of consecutive data points. The first and last
+    point of a bucket are not stored, they are read directly from the data container.
+  */
+  struct Bucket
+  {
+    double min, max;
+  };
+  
+  enum { MinLevel = 4 ///< level of the finest buckets, 2^MinLevel data points each
+       };
+  
+  QCPDataLevelOfDetail() : mIndexed(0), mValid(false) {}
+  
+  void invalidate() { mValid = false; }
+  bool isValid() const { return mValid; }
+  int indexedCount() const { return mIndexed; }
+  int levelCount() const { return mLevels.size(); }
+  int bucketCount(int level) const { return level >= MinLevel && level-MinLevel < mLevels.size() ? mLevels.at(level-MinLevel).size() : 0; }
+  const Bucket &bucket(int level, int index) const { return mLevels.at(level-MinLevel).at(index); }
+  
+  /*!
+    Returns the coarsest level whose buckets still hold at most half the data points that fall on
+    one pixel, or 0 if the density is too low for any level to help.
+  */
+  int levelForDensity(double pointsPerPixel) const
+  {
+    int level = 0;
+    while (level < MinLevel+mLevels.size()-1 && double(2 << level) <= pointsPerPixel*0.5)
+      ++level;
+    return level >= MinLevel ? level : 0;
+  }
+  
+  /*!
+    Brings the index up to date with the \a count data points starting at \a begin. If the index
+    is still valid, only the points appended since the last call are visited, otherwise it is
+    rebuilt.
+  */
+  template <class Iterator>
+  void update(Iterator begin, int count)
+  {
+    if (!mValid || count < mIndexed)
+    {
+      mLevels.clear();
+      mIndexed = 0;
+      mValid = true;
+    }
+    const int bucketSize = 1 << MinLevel;
+    while (mIndexed+bucketSize <= count)
+    {
+      Iterator it = begin+mIndexed;
+      Bucket b;
+      b.min = b.max = mainValueAt(it);
+      for (int i=1; i<bucketSize; ++i)
+      {
+        ++it;
+        const double v = mainValueAt(it);
+        if (v < b.min || qIsNaN(b.min))
+          b.min = v;
+        if (v > b.max || qIsNaN(b.max))
+          b.max = v;
+      }
+      appendBucket(0, b);
+      mIndexed += bucketSize;
+    }
+  }
+  
+protected:
+  QVector<QVector<Bucket> > mLevels; // mLevels[i] holds the buckets of level MinLevel+i
+  int mIndexed; // data points covered by complete finest buckets
+  bool mValid;
+  
+  // the index can be filled from data container iterators or from a plain array of values:
+  template <class Iterator>
+  static double mainValueAt(const Iterator &it) { return it->mainValue(); }
+  static double mainValueAt(const double *it) { return *it; }
+  static double mainValueAt(const float *it) { return *it; }
+  static double mainValueAt(const quint16 *it) { return *it; }
+  
+  void appendBucket(int levelIndex, const Bucket &b)
+  {
+    if (levelIndex == mLevels.size())
+      mLevels.append(QVector<Bucket>());
+    QVector<Bucket> &level = mLevels[levelIndex];
+    level.append(b);
+    if (level.size() % 2 == 0) // every second bucket completes one of the next coarser level
+    {
+      const Bucket &left = level.at(level.size()-2);
+      Bucket parent;
+      parent.min = left.min < b.min || qIsNaN(b.min) ? left.min : b.min;
+      parent.max = left.max > b.max || qIsNaN(b.max) ? left.max : b.max;
+      appendBucket(levelIndex+1, parent);
+    }
+  }
+};
+Q_DECLARE_TYPEINFO(QCPDataLevelOfDetail::Bucket, Q_PRIMITIVE_TYPE);
+
 template <class DataType>
 class QCPDataContainer // no QCP_LIB_DECL, template class ends up in header (cpp included below)
 {
@@ -2622,9 +2730,11 @@ public:
   int size() const { return mData.size()-mPreallocSize; }
   bool isEmpty() const { return size() == 0; }
   bool autoSqueeze() const { return mAutoSqueeze; }
+  bool levelOfDetail() const { return mLevelOfDetail; }
   
   // setters:
   void setAutoSqueeze(bool enabled);
+  void setLevelOfDetail(bool enabled);
   
   // non-virtual methods:
   void set(const QCPDataContainer<DataType> &data);
@@ -2651,15 +2761,19 @@ public:
   QCPRange valueRange(bool &foundRange, QCP::SignDomain signDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange());
   QCPDataRange dataRange() const { return QCPDataRange(0, size()); }
   void limitIteratorsToDataRange(const_iterator &begin, const_iterator &end, const QCPDataRange &dataRange) const;
+  const QCPDataLevelOfDetail *levelOfDetailIndex() const;
+  void invalidateLevelOfDetail() { mLod.invalidate(); }
   
 protected:
   // property members:
   bool mAutoSqueeze;
+  bool mLevelOfDetail;
   
   // non-property memebers:
   QVector<DataType> mData;
   int mPreallocSize;
   int mPreallocIteration;
+  mutable QCPDataLevelOfDetail mLod;
   
   // non-virtual methods:
   void preallocateGrow(int minimumPreallocSize);
@@ -2796,6 +2910,12 @@ protected:
   begin index of the returned range is 0, and the end index is \ref size.
 */
 
+/*! \fn void QCPDataContainer::invalidateLevelOfDetail()
+
+  Makes the level of detail index rebuild on its next use. Only needed after changing main values
+  in-place through the non-const iterators, see \ref setLevelOfDetail.
+*/
+
 /* end documentation of inline functions */
 
 /*!
@@ -2805,6 +2925,7 @@ protected:
 template <class DataType>
 QCPDataContainer<DataType>::QCPDataContainer() :
   mAutoSqueeze(true),
+  mLevelOfDetail(false),
   mPreallocSize(0),
   mPreallocIteration(0)
 {
@@ -2829,6 +2950,43 @@ void QCPDataContainer<DataType>::setAutoSqueeze(bool enabled)
   }
 }
 
+/*!
+  Sets whether the container keeps a level of detail index of its data: a pyramid of the minimum
+  and maximum main value over every aligned block of 2^n consecutive data points. Plottables can
+  use it to draw dense data in time proportional to the number of pixels instead of the number of
+  points (see \ref QCPGraph::setAdaptiveSampling).
+  
+  The index is extended by the points appended since it was last read, so growing the data at the
+  end stays cheap. Any other modification through the container interface makes it rebuild on the
+  next use. If you change main values in-place through the non-const iterators (\ref begin, \ref
+  end), call \ref invalidateLevelOfDetail afterwards.
+  
+  Disabled by default.
+*/
+template <class DataType>
+void QCPDataContainer<DataType>::setLevelOfDetail(bool enabled)
+{
+  if (mLevelOfDetail != enabled)
+  {
+    mLevelOfDetail = enabled;
+    mLod = QCPDataLevelOfDetail();
+  }
+}
+
+/*!
+  Returns the level of detail index of this container, brought up to date with the current data,
+  or \c nullptr if it is disabled (see \ref setLevelOfDetail). Bucket indices are relative to \ref
+  constBegin.
+*/
+template <class DataType>
+const QCPDataLevelOfDetail *QCPDataContainer<DataType>::levelOfDetailIndex() const
+{
+  if (!mLevelOfDetail)
+    return nullptr;
+  mLod.update(constBegin(), size());
+  return &mLod;
+}
+
 /*! \overload
   
   Replaces the current data in this container with the provided \a data.
@@ -2857,6 +3015,7 @@ void QCPDataContainer<DataType>::set(const QVector<DataType> &data, bool already
   mData = data;
   mPreallocSize = 0;
   mPreallocIteration = 0;
+  mLod.invalidate();
   if (!alreadySorted)
     sort();
 }
@@ -2882,12 +3041,16 @@ void QCPDataContainer<DataType>::add(const QCPDataContainer<DataType> &data)
       preallocateGrow(n);
     mPreallocSize -= n;
     std::copy(data.constBegin(), data.constEnd(), begin());
+    mLod.invalidate();
   } else // don't need to prepend, so append and merge if necessary
   {
     mData.resize(mData.size()+n);
     std::copy(data.constBegin(), data.constEnd(), end()-n);
     if (oldSize > 0 && !qcpLessThanSortKey<DataType>(*(constEnd()-n-1), *(constEnd()-n))) // if appended range keys aren't all greater than existing ones, merge the two partitions
+    {
       std::inplace_merge(begin(), end()-n, end(), qcpLessThanSortKey<DataType>);
+      mLod.invalidate();
+    }
   }
 }
 
@@ -2919,6 +3082,7 @@ void QCPDataContainer<DataType>::add(const QVector<DataType> &data, bool already
       preallocateGrow(n);
     mPreallocSize -= n;
     std::copy(data.constBegin(), data.constEnd(), begin());
+    mLod.invalidate();
   } else // don't need to prepend, so append and then sort and merge if necessary
   {
     mData.resize(mData.size()+n);
@@ -2926,7 +3090,10 @@ void QCPDataContainer<DataType>::add(const QVector<DataType> &data, bool already
     if (!alreadySorted) // sort appended subrange if it wasn't already sorted
       std::sort(end()-n, end(), qcpLessThanSortKey<DataType>);
     if (oldSize > 0 && !qcpLessThanSortKey<DataType>(*(constEnd()-n-1), *(constEnd()-n))) // if appended range keys aren't all greater than existing ones, merge the two partitions
+    {
       std::inplace_merge(begin(), end()-n, end(), qcpLessThanSortKey<DataType>);
+      mLod.invalidate();
+    }
   }
 }
 
@@ -2948,10 +3115,12 @@ void QCPDataContainer<DataType>::add(const DataType &data)
       preallocateGrow(1);
     --mPreallocSize;
     *begin() = data;
+    mLod.invalidate();
   } else // handle inserts, maintaining sorted keys
   {
     QCPDataContainer<DataType>::iterator insertionPoint = std::lower_bound(begin(), end(), data, qcpLessThanSortKey<DataType>);
     mData.insert(insertionPoint, data);
+    mLod.invalidate();
   }
 }
 
@@ -2966,6 +3135,7 @@ void QCPDataContainer<DataType>::removeBefore(double sortKey)
   QCPDataContainer<DataType>::iterator it = begin();
   QCPDataContainer<DataType>::iterator itEnd = std::lower_bound(begin(), end(), DataType::fromSortKey(sortKey), qcpLessThanSortKey<DataType>);
   mPreallocSize += int(itEnd-it); // don't actually delete, just add it to the preallocated block (if it gets too large, squeeze will take care of it)
+  mLod.invalidate();
   if (mAutoSqueeze)
     performAutoSqueeze();
 }
@@ -2981,6 +3151,7 @@ void QCPDataContainer<DataType>::removeAfter(double sortKey)
   QCPDataContainer<DataType>::iterator it = std::upper_bound(begin(), end(), DataType::fromSortKey(sortKey), qcpLessThanSortKey<DataType>);
   QCPDataContainer<DataType>::iterator itEnd = end();
   mData.erase(it, itEnd); // typically adds it to the postallocated block
+  mLod.invalidate();
   if (mAutoSqueeze)
     performAutoSqueeze();
 }
@@ -3001,6 +3172,7 @@ void QCPDataContainer<DataType>::remove(double sortKeyFrom, double sortKeyTo)
   QCPDataContainer<DataType>::iterator it = std::lower_bound(begin(), end(), DataType::fromSortKey(sortKeyFrom), qcpLessThanSortKey<DataType>);
   QCPDataContainer<DataType>::iterator itEnd = std::upper_bound(it, end(), DataType::fromSortKey(sortKeyTo), qcpLessThanSortKey<DataType>);
   mData.erase(it, itEnd);
+  mLod.invalidate();
   if (mAutoSqueeze)
     performAutoSqueeze();
 }
@@ -3024,6 +3196,7 @@ void QCPDataContainer<DataType>::remove(double sortKey)
       ++mPreallocSize; // don't actually delete, just add it to the preallocated block (if it gets too large, squeeze will take care of it)
     else
       mData.erase(it);
+    mLod.invalidate();
   }
   if (mAutoSqueeze)
     performAutoSqueeze();
@@ -3040,6 +3213,7 @@ void QCPDataContainer<DataType>::clear()
   mData.clear();
   mPreallocIteration = 0;
   mPreallocSize = 0;
+  mLod.invalidate();
 }
 
 /*!
@@ -3057,6 +3231,7 @@ template <class DataType>
 void QCPDataContainer<DataType>::sort()
 {
   std::sort(begin(), end(), qcpLessThanSortKey<DataType>);
+  mLod.invalidate();
 }
 
 /*!
@@ -3846,6 +4021,7 @@ public:
   QCP::SelectionRectMode selectionRectMode() const { return mSelectionRectMode; }
   QCPSelectionRect *selectionRect() const { return mSelectionRect; }
   bool openGl() const { return mOpenGl; }
+  QCPAbstractPlottable *streamingPlottable() const { return mStreamingPlottable.data(); }
   
   // setters:
   void setViewport(const QRect &rect);
@@ -3870,6 +4046,7 @@ public:
   void setSelectionRectMode(QCP::SelectionRectMode mode);
   void setSelectionRect(QCPSelectionRect *selectionRect);
   void setOpenGl(bool enabled, int multisampling=16);
+  void setStreamingPlottable(QCPAbstractPlottable *plottable);
   
   // non-property methods:
   // plottable interface:
@@ -3939,6 +4116,7 @@ public:
   QPixmap toPixmap(int width=0, int height=0, double scale=1.0);
   void toPainter(QCPPainter *painter, int width=0, int height=0);
   Q_SLOT void replot(QCustomPlot::RefreshPriority refreshPriority=QCustomPlot::rpRefreshHint);
+  Q_SLOT void replotStreaming(QCustomPlot::RefreshPriority refreshPriority=QCustomPlot::rpRefreshHint);
   double replotTime(bool average=false) const;
   
   QCPAxis *xAxis, *yAxis, *xAxis2, *yAxis2;
@@ -3990,6 +4168,7 @@ protected:
   QCP::SelectionRectMode mSelectionRectMode;
   QCPSelectionRect *mSelectionRect;
   bool mOpenGl;
+  QPointer<QCPAbstractPlottable> mStreamingPlottable;
   
   // non-property members:
   QList<QSharedPointer<QCPAbstractPaintBuffer> > mPaintBuffers;
@@ -4005,6 +4184,13 @@ protected:
   int mOpenGlMultisamples;
   QCP::AntialiasedElements mOpenGlAntialiasedElementsBackup;
   bool mOpenGlCacheLabelsBackup;
+  QPointer<QCPLayer> mStreamingRestoreLayer; // layer the streaming plottable came from
+  QVector<double> mStreamingView; // view of the streaming plottable at the last full replot, see streamingView
+  QThreadPool *mStreamingPool; // single worker for phThreadedStreaming, created on first use
+  bool mStreamingJobRunning;
+  bool mStreamingPending;
+  QPicture mStreamingPendingPicture; // newest recording while a job runs, older ones are dropped
+  quint64 mStreamingGeneration; // counts full replots, frames rasterized for an older one are discarded
 #ifdef QCP_OPENGL_FBO
   QSharedPointer<QOpenGLContext> mGlContext;
   QSharedPointer<QSurface> mGlSurface;
@@ -4030,6 +4216,7 @@ protected:
   Q_SLOT virtual void processRectSelection(QRect rect, QMouseEvent *event);
   Q_SLOT virtual void processRectZoom(QRect rect, QMouseEvent *event);
   Q_SLOT virtual void processPointSelection(QMouseEvent *event);
+  Q_SLOT void processStreamingFrame(const QImage &image, quint64 generation);
   
   // non-virtual methods:
   bool registerPlottable(QCPAbstractPlottable *plottable);
@@ -4042,6 +4229,8 @@ protected:
   void setupPaintBuffers();
   QCPAbstractPaintBuffer *createPaintBuffer();
   bool hasInvalidatedPaintBuffers();
+  QVector<double> streamingView() const;
+  void startStreamingJob(const QPicture &picture);
   bool setupOpenGl();
   void freeOpenGl();
   
@@ -5565,6 +5754,9 @@ protected:
   virtual void drawImpulsePlot(QCPPainter *painter, const QVector<QPointF> &lines) const;
   
   virtual void getOptimizedLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end) const;
+  void getLevelOfDetailLineData(QVector<QCPGraphData> *lineData, const QCPDataLevelOfDetail &lod, int beginIndex, int endIndex, int level) const;
+  int getAdaptiveLineData(QVector<QCPGraphData> *lineData, QVector<QPair<int, int> > *intervalStarts, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end, int first, int stop, double keyEpsilon) const;
+  bool getParallelLineData(QVector<QCPGraphData> *lineData, const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end, double keyEpsilon, int shardCount) const;
   virtual void getOptimizedScatterData(QVector<QCPGraphData> *scatterData, QCPGraphDataContainer::const_iterator begin, QCPGraphDataContainer::const_iterator end) const;
   
   // non-virtual methods:
@@ -5580,6 +5772,7 @@ protected:
   QVector<QPair<QCPDataRange, QCPDataRange> > getOverlappingSegments(QVector<QCPDataRange> thisSegments, const QVector<QPointF> *thisData, QVector<QCPDataRange> otherSegments, const QVector<QPointF> *otherData) const;
   bool segmentsIntersect(double aLower, double aUpper, double bLower, double bUpper, int &bPrecedence) const;
   QPointF getFillBasePoint(QPointF matchingDataPoint) const;
+  static QCPGraphDataContainer::const_iterator expandPixelInterval(const QCPGraphDataContainer::const_iterator &begin, const QCPGraphDataContainer::const_iterator &end, double keyLimit, double &minValue, double &maxValue);
   const QPolygonF getFillPolygon(const QVector<QPointF> *lineData, QCPDataRange segment) const;
   const QPolygonF getChannelFillPolygon(const QVector<QPointF> *thisData, QCPDataRange thisSegment, const QVector<QPointF> *otherData, QCPDataRange otherSegment) const;
   int findIndexBelowX(const QVector<QPointF> *data, double x) const;
@@ -5590,12 +5783,207 @@ protected:
   
   friend class QCustomPlot;
   friend class QCPLegend;
+  friend class QCPGraphLineDataJob;
 };
 Q_DECLARE_METATYPE(QCPGraph::LineStyle)
 
 /* end of 'src/plottables/plottable-graph.h' */
 
 
+/* including file 'src/plottables/plottable-uniformgraph.h' */
+
+class QCP_LIB_DECL QCPUniformDataContainer
+{
+public:
+  /*!
+    Defines how the values are stored. The stored number \a s of a data point represents the value
+    <tt>valueOffset + valueScale*s</tt>, see \ref setValueScale.
+    \see setStorageFormat
+  */
+  enum StorageFormat { sfDouble ///< 8 bytes per data point
+                       ,sfFloat ///< 4 bytes per data point, float precision
+                       ,sfUInt16 ///< 2 bytes per data point, e.g. raw ADC codes. NaN can't be stored, so there are no gaps
+                     };
+  
+  QCPUniformDataContainer();
+  
+  // getters:
+  int size() const { return mCount; }
+  bool isEmpty() const { return mCount == 0; }
+  double keyOffset() const { return mKeyOffset; }
+  double keyStep() const { return mKeyStep; }
+  qint64 firstIndex() const { return mFirstIndex; }
+  int capacity() const { return mCapacity; }
+  StorageFormat storageFormat() const { return mFormat; }
+  double valueOffset() const { return mValueOffset; }
+  double valueScale() const { return mValueScale; }
+  bool levelOfDetail() const { return mLevelOfDetail; }
+  
+  // setters:
+  void setKeySampling(double keyOffset, double keyStep);
+  void setCapacity(int capacity);
+  void setStorageFormat(StorageFormat format);
+  void setValueScale(double valueOffset, double valueScale);
+  void setLevelOfDetail(bool enabled);
+  
+  // non-property methods:
+  void set(const QVector<double> &values);
+  void add(const double *values, int count);
+  void add(const QVector<double> &values);
+  void add(double value);
+  void addRaw(const float *values, int count);
+  void addRaw(const quint16 *codes, int count);
+  void removeFirst(int count);
+  void clear();
+  void squeeze();
+  
+  inline double key(int index) const { return mKeyOffset+double(mFirstIndex+index)*mKeyStep; }
+  inline double value(int index) const;
+  int findBegin(double key, bool expandedRange=true) const;
+  int findEnd(double key, bool expandedRange=true) const;
+  QCPRange keyRange(bool &foundRange, QCP::SignDomain signDomain=QCP::sdBoth) const;
+  QCPRange valueRange(bool &foundRange, QCP::SignDomain signDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const;
+  void expandValueSpan(int begin, int end, double &minValue, double &maxValue) const;
+  QCPDataRange dataRange() const { return QCPDataRange(0, size()); }
+  
+protected:
+  // property members:
+  double mKeyOffset, mKeyStep;
+  int mCapacity;
+  StorageFormat mFormat;
+  double mValueOffset, mValueScale;
+  bool mLevelOfDetail;
+  
+  // non-property members:
+  QVector<double> mValues; // storage of sfDouble
+  QVector<float> mFloatValues; // storage of sfFloat
+  QVector<quint16> mCodes; // storage of sfUInt16
+  int mHead; // storage position of the first data point, always 0 without a capacity
+  int mCount;
+  qint64 mFirstIndex; // data points removed from the front since the last clear, for the keys
+  mutable QCPDataLevelOfDetail mLod; // indexes the stored numbers, not the scaled values
+  
+  // non-virtual methods:
+  int indexAtOrAbove(double key) const;
+  int indexAbove(double key) const;
+  const QCPDataLevelOfDetail *levelOfDetailIndex() const;
+  void resetStorage();
+  template <class T>
+  void append(QVector<T> &storage, const T *stored, int count);
+  template <class T>
+  void dropFront(QVector<T> &storage, int count);
+};
+
+double QCPUniformDataContainer::value(int index) const
+{
+  switch (mFormat)
+  {
+    case sfFloat: return mValueOffset+mValueScale*mFloatValues.at(mHead+index);
+    case sfUInt16: return mValueOffset+mValueScale*mCodes.at(mHead+index);
+    default: return mValueOffset+mValueScale*mValues.at(mHead+index);
+  }
+}
+
+
+class QCP_LIB_DECL QCPUniformGraph : public QCPAbstractPlottable, public QCPPlottableInterface1D
+{
+  Q_OBJECT
+  /// \cond INCLUDE_QPROPERTIES
+  Q_PROPERTY(LineStyle lineStyle READ lineStyle WRITE setLineStyle)
+  Q_PROPERTY(QCPScatterStyle scatterStyle READ scatterStyle WRITE setScatterStyle)
+  Q_PROPERTY(int scatterSkip READ scatterSkip WRITE setScatterSkip)
+  Q_PROPERTY(bool adaptiveSampling READ adaptiveSampling WRITE setAdaptiveSampling)
+  /// \endcond
+public:
+  /*!
+    Defines how the graph's line is represented visually in the plot. The line is drawn with the
+    current pen of the graph (\ref setPen).
+    \see setLineStyle
+  */
+  enum LineStyle { lsNone ///< data points are not connected with any lines (e.g. data only represented
+                          ///< with symbols according to the scatter style, see \ref setScatterStyle)
+                   ,lsLine ///< data points are connected by a straight line
+                 };
+  Q_ENUMS(LineStyle)
+  
+  explicit QCPUniformGraph(QCPAxis *keyAxis, QCPAxis *valueAxis);
+  virtual ~QCPUniformGraph() Q_DECL_OVERRIDE;
+  
+  // getters:
+  QSharedPointer<QCPUniformDataContainer> data() const { return mDataContainer; }
+  LineStyle lineStyle() const { return mLineStyle; }
+  QCPScatterStyle scatterStyle() const { return mScatterStyle; }
+  int scatterSkip() const { return mScatterSkip; }
+  bool adaptiveSampling() const { return mAdaptiveSampling; }
+  
+  // setters:
+  void setData(QSharedPointer<QCPUniformDataContainer> data);
+  void setData(double keyOffset, double keyStep, const QVector<double> &values);
+  void setLineStyle(LineStyle ls);
+  void setScatterStyle(const QCPScatterStyle &style);
+  void setScatterSkip(int skip);
+  void setAdaptiveSampling(bool enabled);
+  
+  // non-property methods:
+  void addData(const QVector<double> &values);
+  void addData(double value);
+  
+  // virtual methods of 1d plottable interface:
+  virtual int dataCount() const Q_DECL_OVERRIDE;
+  virtual double dataMainKey(int index) const Q_DECL_OVERRIDE;
+  virtual double dataSortKey(int index) const Q_DECL_OVERRIDE;
+  virtual double dataMainValue(int index) const Q_DECL_OVERRIDE;
+  virtual QCPRange dataValueRange(int index) const Q_DECL_OVERRIDE;
+  virtual QPointF dataPixelPosition(int index) const Q_DECL_OVERRIDE;
+  virtual bool sortKeyIsMainKey() const Q_DECL_OVERRIDE;
+  virtual QCPDataSelection selectTestRect(const QRectF &rect, bool onlySelectable) const Q_DECL_OVERRIDE;
+  virtual int findBegin(double sortKey, bool expandedRange=true) const Q_DECL_OVERRIDE;
+  virtual int findEnd(double sortKey, bool expandedRange=true) const Q_DECL_OVERRIDE;
+  
+  // reimplemented virtual methods:
+  virtual double selectTest(const QPointF &pos, bool onlySelectable, QVariant *details=nullptr) const Q_DECL_OVERRIDE;
+  virtual QCPPlottableInterface1D *interface1D() Q_DECL_OVERRIDE { return this; }
+  virtual QCPRange getKeyRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth) const Q_DECL_OVERRIDE;
+  virtual QCPRange getValueRange(bool &foundRange, QCP::SignDomain inSignDomain=QCP::sdBoth, const QCPRange &inKeyRange=QCPRange()) const Q_DECL_OVERRIDE;
+  
+protected:
+  // property members:
+  QSharedPointer<QCPUniformDataContainer> mDataContainer;
+  LineStyle mLineStyle;
+  QCPScatterStyle mScatterStyle;
+  int mScatterSkip;
+  bool mAdaptiveSampling;
+  
+  // reimplemented virtual methods:
+  virtual void draw(QCPPainter *painter) Q_DECL_OVERRIDE;
+  virtual void drawLegendIcon(QCPPainter *painter, const QRectF &rect) const Q_DECL_OVERRIDE;
+  
+  // introduced virtual methods:
+  virtual void drawScatterPlot(QCPPainter *painter, const QVector<QPointF> &scatters, const QCPScatterStyle &style) const;
+  virtual void drawLinePlot(QCPPainter *painter, const QVector<QPointF> &lines) const;
+  virtual void getOptimizedLineData(QVector<QCPGraphData> *lineData, int begin, int end) const;
+  virtual void getOptimizedScatterData(QVector<QCPGraphData> *scatterData, int begin, int end) const;
+  
+  // non-virtual methods:
+  void getDataSegments(QList<QCPDataRange> &selectedSegments, QList<QCPDataRange> &unselectedSegments) const;
+  void getVisibleDataBounds(int &begin, int &end, const QCPDataRange &rangeRestriction) const;
+  void getLines(QVector<QPointF> *lines, const QCPDataRange &dataRange) const;
+  void getScatters(QVector<QPointF> *scatters, const QCPDataRange &dataRange) const;
+  QVector<QPointF> dataToPixels(const QVector<QCPGraphData> &data) const;
+  void drawPolyline(QCPPainter *painter, const QVector<QPointF> &lineData) const;
+  double pointDistance(const QPointF &pixelPoint, int &closestData) const;
+  
+private:
+  Q_DISABLE_COPY(QCPUniformGraph)
+  
+  friend class QCustomPlot;
+  friend class QCPLegend;
+};
+Q_DECLARE_METATYPE(QCPUniformGraph::LineStyle)
+
+/* end of 'src/plottables/plottable-uniformgraph.h' */
+
+
 /* including file 'src/plottables/plottable-curve.h' */
 /* modified 2022-11-06T12:45:56, size 7434           */
 
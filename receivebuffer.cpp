@@ -0,0 +1,84 @@
+#include "receivebuffer.h"
+#include <cstring>
+
+receiveBuffer::receiveBuffer(int capacity)
+    : basePos(0)
+    , readPos(0)
+    , writePos(0)
+    , dropped(0)
+{
+    storage.resize(qMax(capacity, 64));
+}
+
+void receiveBuffer::setCapacity(int capacity)
+{
+    capacity = qMax(capacity, 64);
+
+    //Keep the newest unread bytes that still fit
+    if(available() > capacity)
+    {
+        const int excess = available() - capacity;
+        dropped += excess;
+        readPos += excess;
+    }
+
+    compact();
+    storage.resize(capacity);
+    storage.squeeze();
+}
+
+void receiveBuffer::clear()
+{
+    readPos = writePos;
+    basePos = writePos;
+}
+
+char *receiveBuffer::writeSpace(int wanted, int *granted)
+{
+    const int cap = capacity();
+    wanted = qMin(qMax(wanted, 0), cap);
+
+    int tailRoom = cap - static_cast<int>(writePos - basePos);
+    if(tailRoom < wanted)
+    {
+        //Make room by discarding the oldest unread bytes first, then compact
+        const int freeTotal = cap - available();
+        if(freeTotal < wanted)
+        {
+            const int excess = wanted - freeTotal;
+            dropped += excess;
+            readPos += excess;
+        }
+        compact();
+        tailRoom = cap - static_cast<int>(writePos - basePos);
+    }
+
+    *granted = qMin(wanted, tailRoom);
+    return storage.data() + (writePos - basePos);
+}
+
+void receiveBuffer::commit(int written)
+{
+    writePos += written;
+}
+
+void receiveBuffer::consume(int count)
+{
+    readPos += qMin(count, available());
+
+    //Everything read: restart at the front for free, no bytes to move
+    if(readPos == writePos)
+    {
+        basePos = writePos;
+    }
+}
+
+void receiveBuffer::compact()
+{
+    const int unread = available();
+    if(readPos != basePos && unread > 0)
+    {
+        memmove(storage.data(), storage.constData() + (readPos - basePos), static_cast<size_t>(unread));
+    }
+    basePos = readPos;
+}
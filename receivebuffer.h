@@ -0,0 +1,54 @@
+#ifndef RECEIVEBUFFER_H
+#define RECEIVEBUFFER_H
+
+#include <QtGlobal>
+#include <QVector>
+
+// Fixed-capacity receive storage for serialPortHandler.
+//
+// Bytes are addressed by 64-bit stream positions that only ever grow, so a
+// session can run for as long as the jig keeps sending. The storage itself
+// never grows past capacity(): consumed bytes are dropped by compacting the
+// (normally tiny) unread tail to the front instead of wrapping, which keeps
+// every unread byte contiguous so the frame parsers can hand out plain pointer
+// views into it. If the reader falls behind by more than the capacity the
+// oldest unread bytes are discarded and counted in droppedBytes().
+class receiveBuffer
+{
+public:
+    enum { DefaultCapacity = 256 * 1024 };
+
+    explicit receiveBuffer(int capacity = DefaultCapacity);
+
+    //Memory ceiling in bytes. Unread bytes that do not fit are dropped.
+    void setCapacity(int capacity);
+    int capacity() const { return storage.size(); }
+
+    //Forgets all unread bytes, stream positions keep counting
+    void clear();
+
+    //Writer side: returns a contiguous region of up to wanted bytes (granted
+    //receives the actual size) to fill, then commit() what was written.
+    char *writeSpace(int wanted, int *granted);
+    void commit(int written);
+
+    //Reader side
+    const uchar *readPtr() const { return reinterpret_cast<const uchar *>(storage.constData()) + (readPos - basePos); }
+    int available() const { return static_cast<int>(writePos - readPos); }
+    void consume(int count);
+
+    quint64 readPosition() const { return readPos; }
+    quint64 writePosition() const { return writePos; }
+    quint64 droppedBytes() const { return dropped; }
+
+private:
+    void compact();
+
+    QVector<char> storage;
+    quint64 basePos;  //stream position of storage[0]
+    quint64 readPos;
+    quint64 writePos;
+    quint64 dropped;
+};
+
+#endif // RECEIVEBUFFER_H
@@ -0,0 +1,155 @@
+#include "replotscheduler.h"
+#include "qcustomplot.h"
+#include <QWindow>
+#include <QEvent>
+#include <cmath>
+
+namespace
+{
+    //Weight of the newest frame in the smoothed frame cost
+    const double CostSmoothing = 0.2;
+    //Longest wait for the window's update request before a frame is rendered anyway, e.g. when minimized
+    const int MaxVsyncWaitMs = 100;
+}
+
+replotScheduler::replotScheduler(QCustomPlot *target, QObject *parent) : QObject(parent), plot(target)
+{
+    frameTimer.setSingleShot(true);
+    frameTimer.setTimerType(Qt::PreciseTimer);
+    connect(&frameTimer, &QTimer::timeout, this, &replotScheduler::timerExpired);
+    clock.start();
+}
+
+void replotScheduler::setTargetRate(double framesPerSecond)
+{
+    if(framesPerSecond > 0.0)
+    {
+        targetIntervalMs = 1000.0 / framesPerSecond;
+    }
+}
+
+void replotScheduler::setPacing(pacing requested)
+{
+    mode = requested;
+    if(mode == vsyncPacing)
+    {
+        paceWindow();
+    }
+}
+
+void replotScheduler::setFrameBudget(double ms)
+{
+    budgetMs = qMax(ms, 0.0);
+}
+
+double replotScheduler::frameInterval() const
+{
+    if(budgetMs > 0.0 && costMs > budgetMs)
+    {
+        return targetIntervalMs * costMs / budgetMs;
+    }
+    return targetIntervalMs;
+}
+
+void replotScheduler::requestReplot()
+{
+    dirty = true;
+    arm();
+}
+
+void replotScheduler::flush()
+{
+    if(dirty)
+    {
+        frame();
+    }
+}
+
+void replotScheduler::arm()
+{
+    if(armed || !dirty)
+    {
+        return;
+    }
+    armed = true;
+
+    //The first frame goes out right away, later ones keep the interval from the previous frame's start
+    qint64 waitMs = 0;
+    if(frames > 0)
+    {
+        const double dueNs = lastFrameNs + frameInterval() * 1e6;
+        waitMs = static_cast<qint64>(std::ceil((dueNs - clock.nsecsElapsed()) / 1e6));
+    }
+    frameTimer.start(static_cast<int>(qBound<qint64>(0, waitMs, 1000)));
+}
+
+void replotScheduler::timerExpired()
+{
+    if(mode == vsyncPacing && !waitingForWindow)
+    {
+        //Interval is over, render when the window is next ready to show a frame
+        if(QWindow *window = paceWindow())
+        {
+            waitingForWindow = true;
+            window->requestUpdate();
+            frameTimer.start(MaxVsyncWaitMs);
+            return;
+        }
+    }
+    frame();
+}
+
+bool replotScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    //Observe only, the window still handles its own update request
+    if(event->type() == QEvent::UpdateRequest && watched == filteredWindow && waitingForWindow)
+    {
+        frame();
+    }
+    return QObject::eventFilter(watched, event);
+}
+
+void replotScheduler::frame()
+{
+    frameTimer.stop();
+    armed = false;
+    waitingForWindow = false;
+    if(!dirty)
+    {
+        return;
+    }
+    dirty = false;
+
+    const qint64 startNs = clock.nsecsElapsed();
+    lastFrameNs = startNs;
+
+    emit frameDue();
+    //Draw into the paint buffers now, only the streaming layer's if the axes didn't move;
+    //the widget blits them in its next paint event
+    plot->replotStreaming(QCustomPlot::rpQueuedRefresh);
+
+    const double cost = (clock.nsecsElapsed() - startNs) / 1e6;
+    costMs = frames == 0 ? cost : costMs + CostSmoothing * (cost - costMs);
+    ++frames;
+
+    //Requests made while the frame was prepared get the next one
+    arm();
+}
+
+QWindow *replotScheduler::paceWindow()
+{
+    QWindow *window = plot->window()->windowHandle();
+    if(window != filteredWindow)
+    {
+        if(filteredWindow)
+        {
+            filteredWindow->removeEventFilter(this);
+        }
+        if(window)
+        {
+            window->installEventFilter(this);
+        }
+        filteredWindow = window;
+    }
+    return window && window->isExposed() ? window : nullptr;
+}
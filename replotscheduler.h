@@ -0,0 +1,79 @@
+#ifndef REPLOTSCHEDULER_H
+#define REPLOTSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QPointer>
+
+class QCustomPlot;
+class QWindow;
+
+// Paces the replots of one QCustomPlot independently of how often its data
+// changes. requestReplot() only marks the plot dirty; at most one frame per
+// target interval then emits frameDue() (where the owner moves new data into
+// the plottables) and replots. Any number of requests between two frames cost
+// one replot, so the ingest rate and the render rate are decoupled.
+//
+// Frames are paced by a precise timer, or by QWindow::requestUpdate() so they
+// line up with the display refresh where the platform supports it. If a frame
+// takes longer than the frame budget, the interval is stretched in proportion
+// (a 16 ms replot against an 8 ms budget halves the rate), so rendering never
+// takes more than budget/interval of the GUI thread.
+class replotScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    enum pacing { timerPacing, vsyncPacing };
+
+    explicit replotScheduler(QCustomPlot *target, QObject *parent = nullptr);
+
+    void setTargetRate(double framesPerSecond);
+    double targetRate() const { return 1000.0 / targetIntervalMs; }
+
+    void setPacing(pacing requested);
+    pacing pacingMode() const { return mode; }
+
+    void setFrameBudget(double ms);
+    double frameBudget() const { return budgetMs; }
+
+    //Smoothed cost of one frame (frameDue() handlers plus replot) and the resulting interval
+    double frameCost() const { return costMs; }
+    double frameInterval() const;
+    quint64 framesRendered() const { return frames; }
+
+public slots:
+    void requestReplot();
+    //Renders a pending frame right away, e.g. when a run ends
+    void flush();
+
+signals:
+    void frameDue();
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private slots:
+    void frame();
+    void timerExpired();
+
+private:
+    void arm();
+    QWindow *paceWindow();
+
+    QCustomPlot *plot;
+    QPointer<QWindow> filteredWindow;
+    QTimer frameTimer;
+    QElapsedTimer clock;
+    qint64 lastFrameNs = 0;
+    double targetIntervalMs = 1000.0 / 60.0;
+    double budgetMs = 8.0;
+    double costMs = 0.0;
+    pacing mode = timerPacing;
+    bool dirty = false;
+    bool armed = false;
+    bool waitingForWindow = false;
+    quint64 frames = 0;
+};
+
+#endif // REPLOTSCHEDULER_H
@@ -1,9 +1,22 @@
 #include "serialporthandler.h"
-int serialPortHandler::processedBytes = 0;
+#include "asynclogger.h"
 
 serialPortHandler::serialPortHandler(QObject *parent) : QObject(parent)
+  , liveNotifyPending(false)
+  , batchFrames(MaxBatchFrames)
+  , batchCount(0)
+  , batchSequence(0)
+  , framesDelivered(0)
 {
-    serial = new QSerialPort;
+    //Parented so that moveToThread() carries the port along to the acquisition thread
+    serial = new QSerialPort(this);
+    terminatorTimer = new QTimer(this);
+    terminatorTimer->setSingleShot(true);
+    terminatorTimer->setInterval(TerminatorQuietMs);
+    connect(terminatorTimer, &QTimer::timeout, this, &serialPortHandler::completeLiveRun);
+    statsClock.start();
+    summaryClock.start();
+    lastSummary = stats.snapshot(0, 0);
     connect(serial, &QSerialPort::readyRead, this, &serialPortHandler::readData);
 
 }
@@ -25,7 +38,7 @@ QStringList serialPortHandler::availablePorts()
 
 void serialPortHandler::setPORTNAME(const QString &portName)
 {
-    buffer.clear();
+    rxBuffer.clear();
 
     if(serial->isOpen())
     {
@@ -52,247 +65,487 @@ void serialPortHandler::setPORTNAME(const QString &portName)
     }
 }
 
-float serialPortHandler::convertBytesToFloat(const QByteArray &data)
+void serialPortHandler::readData()
 {
-    if(data.size() != 4)
-    {
-        qDebug()<<"Insuffient data to convert into float";
+    // Read data from the serial port
+    if (serial->bytesAvailable() == 0) {
+        qWarning() << "No bytes available from serial port";
+        return;  // Early return if no data is available
     }
 
-    // Assuming little-endian format
-    QByteArray floatBytes = data;
-    std::reverse(floatBytes.begin(), floatBytes.end()); // Convert to big-endian if needed
+    // Create a QMutexLocker to manage the mutex
+    QMutexLocker locker(&bufferMutex); // Lock the mutex
 
-    float value;
-    memcpy(&value, floatBytes.constData(), sizeof(float));
-    return value;
-}
 
-quint8 serialPortHandler::chkSum(const QByteArray &data)
-{
-    // Ensure the QByteArray has at least two bytes (data + checksum)
-    if (data.size() < 2) {
-        throw std::invalid_argument("Data size must be at least 2 for checksum calculation.");
+    // Read straight into the receive storage, it never grows past its capacity.
+    // Each read only takes what fits next to the unparsed bytes and is parsed
+    // before the next one, so a burst larger than the storage never pushes out
+    // bytes the parser has not seen (which would misalign the live frames).
+    const quint64 droppedBefore = rxBuffer.droppedBytes();
+    const quint64 writtenBefore = rxBuffer.writePosition();
+    qint64 pending;
+    while ((pending = serial->bytesAvailable()) > 0) {
+        int granted = 0;
+        char *dst = rxBuffer.writeSpace(static_cast<int>(qMin<qint64>(pending, receiveRoom())), &granted);
+        const qint64 got = serial->read(dst, granted);
+        if (got <= 0) {
+            break;
+        }
+        rxBuffer.commit(static_cast<int>(got));
+        recorder.recordBytes(dst, got);
+        parseChunk();
     }
 
-    // Initialize checksum to 0
-    quint8 checksum = 0;
+    processBurst(droppedBefore, writtenBefore);
+}
 
-    // Perform XOR for all bytes except the last one
-    for (int i = 0; i < data.size() - 1; ++i) {
-        checksum ^= static_cast<quint8>(data[i]);
+void serialPortHandler::injectBytes(const char *data, int len)
+{
+    QMutexLocker locker(&bufferMutex);
+
+    const quint64 droppedBefore = rxBuffer.droppedBytes();
+    const quint64 writtenBefore = rxBuffer.writePosition();
+    while (len > 0) {
+        int granted = 0;
+        char *dst = rxBuffer.writeSpace(qMin(len, receiveRoom()), &granted);
+        memcpy(dst, data, static_cast<size_t>(granted));
+        rxBuffer.commit(granted);
+        recorder.recordBytes(dst, granted);
+        parseChunk();
+        data += granted;
+        len -= granted;
     }
 
-    qDebug()<<hex<<checksum<<"DEBUG_CHKSUM";
-    return checksum;
+    processBurst(droppedBefore, writtenBefore);
 }
 
-void serialPortHandler::readData()
+int serialPortHandler::receiveRoom() const
 {
-    qDebug()<<"------------------------------------------------------------------------------------";
-    emit portOpening("------------------------------------------------------------------------------------");
-    QByteArray ResponseData;
+    //The frame parsers leave less than one frame unparsed, so there is always room.
+    //Only bytes of an unknown msgId stay unparsed; once they fill the storage the
+    //oldest of them are dropped to make room.
+    const int room = rxBuffer.capacity() - rxBuffer.available();
+    return room > 0 ? room : rxBuffer.capacity();
+}
 
-    // Read data from the serial port
-    if (serial->bytesAvailable() == 0) {
-        qWarning() << "No bytes available from serial port";
-        return;  // Early return if no data is available
+void serialPortHandler::parseChunk()
+{
+    if (awaitingResponse) {
+        awaitingResponse = false;
+        emit dataReceived(); // Signal data has been received
     }
 
-    // Create a QMutexLocker to manage the mutex
-    QMutexLocker locker(&bufferMutex); // Lock the mutex
+    if(verbose())
+    {
+        //Non-owning view of the unread bytes for the debug output
+        const QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char *>(rxBuffer.readPtr()),
+                                                          rxBuffer.available());
+        if(id != jigProtocol::MsgLive)
+        {
+            qDebug()<<buffer.toHex()<<" Raw buffer data";
+        }
+        qDebug()<<buffer.size()<<" :size";
+    }
+
+    QElapsedTimer parseTimer;
+    parseTimer.start();
+
+    // One table lookup picks the parser instantiated for this msgId's layout
+    (this->*burstTable()[id])(false);
+
+    burstParseNs += static_cast<quint64>(parseTimer.nsecsElapsed());
+}
+
+void serialPortHandler::processBurst(quint64 droppedBefore, quint64 writtenBefore)
+{
+    if(verbose())
+    {
+        qDebug()<<"------------------------------------------------------------------------------------";
+        emit portOpening("------------------------------------------------------------------------------------");
+    }
 
+    const quint64 burstBytes = rxBuffer.writePosition() - writtenBefore;
+    ingestCounters::add(stats.bytesReceived, burstBytes);
+    ingestCounters::add(stats.bursts, 1);
+    ingestCounters::raiseTo(stats.maxBurstBytes, burstBytes);
 
-    if (serial->bytesAvailable() < std::numeric_limits<int>::max()) {
-        buffer.append(serial->readAll()); // Append only if it won't exceed max size
-        if (!buffer.isEmpty()) {
-            emit dataReceived(); // Signal data has been received
+    if (rxBuffer.droppedBytes() != droppedBefore) {
+        ingestCounters::add(stats.resyncs, 1);
+        ingestCounters::add(stats.droppedBytes, rxBuffer.droppedBytes() - droppedBefore);
+        if (verbose()) {
+            qWarning() << "Receive buffer full, dropped" << rxBuffer.droppedBytes() - droppedBefore << "unread bytes";
         }
-    } else {
-        qWarning() << "Attempt to append too much data to QByteArray!";
-        return;
     }
 
+    //The bytes were parsed as they were read, this only ends the burst
+    QElapsedTimer parseTimer;
+    parseTimer.start();
 
-    //Direct taking msgId from mainWindow
-    quint8 msgId = id;
-    //powerId to avoid that warning QByteRef calling out of bond error
-    quint8 powerId = 0x00;
+    (this->*burstTable()[id])(true);
 
-    if(msgId == 0x01)
+    const quint64 parseNs = burstParseNs + static_cast<quint64>(parseTimer.nsecsElapsed());
+    burstParseNs = 0;
+    stats.lastParseNs.store(parseNs, std::memory_order_relaxed);
+    ingestCounters::add(stats.totalParseNs, parseNs);
+
+    if(!verbose() && summaryClock.elapsed() >= SummaryIntervalMs)
     {
-        qDebug()<<buffer.size()<<" :size";
+        reportSummary();
+    }
+}
 
+void serialPortHandler::logEvent(quint16 eventId, const uchar *data, int len)
+{
+    if(eventLogger)
+    {
+        eventLogger->logEvent(eventId, id, data, len);
     }
-    else
+}
+
+void serialPortHandler::reportSummary()
+{
+    summaryClock.restart();
+
+    const ingestSnapshot now = statistics();
+    const ingestSnapshot &was = lastSummary;
+    if(now.bursts != was.bursts)
     {
-        qDebug()<<buffer.toHex()<<" Raw buffer data";
-        qDebug()<<buffer.size()<<" :size";
+        emit executeWriteToNotes(QString("Ingest: %1 bursts, %2 bytes, %3 frames, %4 terminators, %5 checksum failures, "
+                                         "%6 resyncs, %7 dropped bytes, %8 dropped frames, %9 partial frames")
+                                 .arg(now.bursts - was.bursts)
+                                 .arg(now.bytesReceived - was.bytesReceived)
+                                 .arg(now.validFrames - was.validFrames)
+                                 .arg(now.terminatorHits - was.terminatorHits)
+                                 .arg(now.checksumFailures - was.checksumFailures)
+                                 .arg(now.resyncs - was.resyncs)
+                                 .arg(now.droppedBytes - was.droppedBytes)
+                                 .arg(now.droppedFrames - was.droppedFrames)
+                                 .arg(now.partialStalls - was.partialStalls));
     }
+    lastSummary = now;
+}
 
+void serialPortHandler::setDiagnosticsMode(int mode)
+{
+    diagnostics = mode == DiagnosticsVerbose ? DiagnosticsVerbose : DiagnosticsSummary;
+}
+
+// Live stream: frames are decoded into the burst batch, delivered once per burst
+template<>
+struct serialPortHandler::frameSink<jigProtocol::frameLayout<jigProtocol::MsgLive> >
+{
+    typedef jigProtocol::frameLayout<jigProtocol::MsgLive> layout;
 
-    if (msgId == 0x01) {
-        qDebug() << "msgId:" << hex << msgId;
+    explicit frameSink(serialPortHandler *handler) : handler(handler) {}
 
-        // Loop through unprocessed data in the buffer
-        while (buffer.size() - processedBytes >= 3)
+    frameParser<layout> &parser() { return handler->liveParser; }
+
+    void onFrame(const uchar *frame)
+    {
+        if(handler->verbose())
         {
-            QByteArray chunk = buffer.mid(processedBytes); // Extract unprocessed portion
+            handler->logEvent(eventLog::EventLiveFrame, frame, layout::Length);
+        }
 
-            if (chunk.size() >= 3 && chunk.right(3) == QByteArray::fromHex("ffddff"))
-            {
-                powerId = 0x01;
-                ResponseData = chunk.right(3);
-                executeWriteToNotes("Start Command received bytes check: " + ResponseData.toHex());
-                processedBytes = 0;
-                break;
-            }
-            else if (chunk.size() >= 6)
-            {
-                powerId = 0x01;
-                ResponseData = chunk.left(6); // Extract the first 6 bytes
-                processedBytes += 6; // Increment processedBytes offset
-                executeWriteToNotes("Start Command 6 bytes received: " + QString::number(ResponseData.size()));
+        layout::decode(frame, handler->batchFrames[handler->batchCount++]);
 
-                // Emit data for live plotting
-                emit plotLiveData(ResponseData);
-            }
-            else {
-                // Not enough data, wait for more bytes
-                executeWriteToNotes("Start Command received Chunk Size " + QString::number(chunk.size()));
-                break;
-            }
+        if(handler->batchCount == static_cast<int>(handler->batchFrames.size()))
+        {
+            handler->flushLiveBatch();
         }
+    }
+
+    void onTerminator(const uchar *term)
+    {
+        // Everything before the terminator must reach the consumer first
+        handler->flushLiveBatch();
+        ingestCounters::add(handler->stats.terminatorHits, 1);
+
+        handler->logEvent(eventLog::EventLiveTerminator, term, layout::TerminatorLength);
 
+        //Widgets live on the GUI thread, MainWindow shows the completion box
+        emit handler->plotCompleted();
     }
 
-    else if(msgId == 0x02)
+    void onChecksumError(const uchar *) {}
+    void onResync() {}
+
+    void finish()
     {
-        qDebug() << "msgId:" <<hex<<msgId;
+        // One batch per read burst
+        handler->flushLiveBatch();
 
-        if(buffer.size() == 17
-                && static_cast<unsigned char>(buffer[0]) == 0x54
-                && static_cast<unsigned char>(buffer[1]) == 0x01
-                && static_cast<unsigned char>(buffer[16]) == chkSum(buffer))
-        {
-            powerId = 0x02;
-            ResponseData = buffer;
-            buffer.clear();
-            executeWriteToNotes("Power Card Data received bytes check: "+ResponseData.toHex());
+        // Bytes ending in the terminator wait for the line to go quiet, see completeLiveRun()
+        if (handler->liveParser.state() == frameParser<layout>::Streaming
+                && frameParser<layout>::endsWithTerminator(handler->rxBuffer.readPtr(), handler->rxBuffer.available())) {
+            handler->terminatorTimer->start();
+            return;
+        }
+        handler->terminatorTimer->stop();
+
+        if (handler->liveParser.state() == frameParser<layout>::Streaming && handler->rxBuffer.available() > 0) {
+            // Not enough data, wait for more bytes
+            ingestCounters::add(handler->stats.partialStalls, 1);
+            if (handler->verbose()) {
+                handler->logEvent(eventLog::EventLivePartial, handler->rxBuffer.readPtr(), handler->rxBuffer.available());
+            }
         }
-        else
+    }
+
+    serialPortHandler *handler;
+};
+
+// Power card: one 17-byte frame per 47 01 request
+template<>
+struct serialPortHandler::frameSink<jigProtocol::frameLayout<jigProtocol::MsgPower> >
+{
+    typedef jigProtocol::frameLayout<jigProtocol::MsgPower> layout;
+
+    explicit frameSink(serialPortHandler *handler) : handler(handler) {}
+
+    frameParser<layout> &parser() { return handler->powerParser; }
+
+    void onFrame(const uchar *frame)
+    {
+        ingestCounters::add(handler->stats.validFrames, 1);
+
+        jigProtocol::powerReading reading;
+        layout::decode(frame, reading);
+
+        if(handler->verbose())
         {
-            executeWriteToNotes("Required 17 bytes Received bytes: "+QString::number(buffer.size())
-                                +" "+buffer.toHex());
+            handler->logEvent(eventLog::EventPowerFrame, frame, layout::Length);
+
+            // Output the results
+            qDebug() << "pos28V:" << reading.volts[0];
+            qDebug() << "pos15V:" << reading.volts[1];
+            qDebug() << "neg15V:" << reading.volts[2];
+            qDebug() << "ext10V:" << reading.volts[3];
+            qDebug() << "pos5V:" << reading.volts[4];
+            qDebug() << "neg5V:" << reading.volts[5];
+            qDebug() << "pos3p3V:" << reading.volts[6];
         }
 
+        QVector<float> powerData(jigProtocol::powerReading::Rails);
+        std::copy(reading.volts, reading.volts + jigProtocol::powerReading::Rails, powerData.begin());
+
+        emit handler->sendPowerData(powerData);
     }
-    else
+
+    void onTerminator(const uchar *) {}
+
+    void onChecksumError(const uchar *)
     {
-        //do nothing
-        qDebug()<<"do nothing not a specified size/unknown msgId";
-        executeWriteToNotes("Fatal Error 404");
+        ingestCounters::add(handler->stats.checksumFailures, 1);
     }
 
-
-    switch(powerId)
+    void onResync()
     {
-    case 0x01:
+        //Counted once per burst in finish(), the burst may be parsed in several reads
+        handler->burstResynced = true;
+    }
+
+    void finish()
     {
-        if(ResponseData.size() == 3)
+        if(handler->burstResynced)
+        {
+            ingestCounters::add(handler->stats.resyncs, 1);
+            handler->burstResynced = false;
+        }
+
+        const int left = handler->rxBuffer.available();
+        if(left > 0)
         {
-            QMessageBox *msgBox = new QMessageBox(nullptr);
-            msgBox->setWindowTitle("Completed");
-            msgBox->setText("Plot Completed Successfully");
-            msgBox->setStandardButtons(QMessageBox::Ok);
-            msgBox->setAttribute(Qt::WA_DeleteOnClose); // Automatically delete when closed
-            msgBox->setModal(false); // Set to non-modal
-            msgBox->show();
+            ingestCounters::add(handler->stats.partialStalls, 1);
         }
-        else if(ResponseData.size() == 6)
+        if(left > 0 && handler->verbose())
         {
-            emit plotLiveData(ResponseData);
+            handler->logEvent(eventLog::EventPowerPartial, handler->rxBuffer.readPtr(), left);
         }
     }
-        break;
 
-    case 0x02:
+    serialPortHandler *handler;
+};
+
+const serialPortHandler::burstFunction *serialPortHandler::burstTable()
+{
+    struct table
     {
+        table()
+        {
+            for(int i = 0; i < 256; ++i)
+            {
+                entries[i] = &serialPortHandler::processUnknown;
+            }
+            entries[jigProtocol::MsgLive] = &serialPortHandler::processFrames<jigProtocol::frameLayout<jigProtocol::MsgLive> >;
+            entries[jigProtocol::MsgPower] = &serialPortHandler::processFrames<jigProtocol::frameLayout<jigProtocol::MsgPower> >;
+        }
 
-        // Assuming ResponseData and realData are defined and contain valid data.
-        QByteArray realData = ResponseData.mid(2, 14);
+        burstFunction entries[256];
+    };
 
-        // Ensure that realData has exactly 14 bytes
-        if (realData.size() != 14) {
-            qWarning() << "Invalid data size. Expected 14 bytes.";
-            return;
-        }
+    static const table dispatch;
+    return dispatch.entries;
+}
+
+template<typename Layout>
+void serialPortHandler::processFrames(bool endOfBurst)
+{
+    if(verbose() && !endOfBurst)
+    {
+        qDebug() << "msgId:" << hex << id;
+    }
+
+    // Walk the unread bytes in place, frames are delivered straight from the receive storage
+    frameSink<Layout> sink(this);
+    rxBuffer.consume(static_cast<int>(sink.parser().parse(rxBuffer.readPtr(), rxBuffer.available(), sink)));
+    if(endOfBurst)
+    {
+        sink.finish();
+    }
+}
 
-        // Define variables to store the calculated values
-        float pos28V = 0.0f, pos15V = 0.0f, neg15V = 0.0f, ext10V = 0.0f, pos5V = 0.0f, neg5V = 0.0f, pos3p3V = 0.0f;
-
-        // Helper lambda to calculate the scaled value
-        auto calculateScaledValue = [](quint16 rawValue) -> float {
-            return ((rawValue * 20.48f) / 4095.0f - 10.24f) * 3;
-        };
-
-        // Helper lambda to calculate special scaled value
-        auto calculateScaledSpecialValue = [](quint16 rawValue) -> float {
-            return (rawValue * 20.48f) / 4095.0f - 10.24f;
-        };
-
-        // Extract and process each pair of bytes
-        pos28V = calculateScaledValue(static_cast<quint16>((static_cast<unsigned char>(realData[0]) << 8) |
-                                      static_cast<unsigned char>(realData[1])));
-        pos15V = calculateScaledValue(static_cast<quint16>((static_cast<unsigned char>(realData[2]) << 8) |
-                                      static_cast<unsigned char>(realData[3])));
-        neg15V = calculateScaledValue(static_cast<quint16>((static_cast<unsigned char>(realData[4]) << 8) |
-                                      static_cast<unsigned char>(realData[5])));
-        ext10V = calculateScaledValue(static_cast<quint16>((static_cast<unsigned char>(realData[6]) << 8) |
-                                      static_cast<unsigned char>(realData[7])));
-        pos5V = calculateScaledSpecialValue(static_cast<quint16>((static_cast<unsigned char>(realData[8]) << 8) |
-                                            static_cast<unsigned char>(realData[9])));
-        neg5V = calculateScaledSpecialValue(static_cast<quint16>((static_cast<unsigned char>(realData[10]) << 8) |
-                                            static_cast<unsigned char>(realData[11])));
-        pos3p3V = calculateScaledSpecialValue(static_cast<quint16>((static_cast<unsigned char>(realData[12]) << 8) |
-                                              static_cast<unsigned char>(realData[13])));
-
-        // Output the results
-        qDebug() << "pos28V:" << pos28V;
-        qDebug() << "pos15V:" << pos15V;
-        qDebug() << "neg15V:" << neg15V;
-        qDebug() << "ext10V:" << ext10V;
-        qDebug() << "pos5V:" << pos5V;
-        qDebug() << "neg5V:" << neg5V;
-        qDebug() << "pos3p3V:" << pos3p3V;
-
-        QVector<float> powerData;
-        powerData.append(pos28V);
-        powerData.append(pos15V);
-        powerData.append(neg15V);
-        powerData.append(ext10V);
-        powerData.append(pos5V);
-        powerData.append(neg5V);
-        powerData.append(pos3p3V);
-
-        emit sendPowerData(powerData);
-
-
-    }
-        break;
-
-    default:
+void serialPortHandler::completeLiveRun()
+{
+    QMutexLocker locker(&bufferMutex);
+
+    if(id != jigProtocol::MsgLive)
     {
-        qDebug() << "Unknown powerId: " <<hex << powerId << " with data: " << ResponseData.size();
+        return;
     }
+
+    //Nothing followed the terminator, so it really ends the run
+    frameSink<jigProtocol::frameLayout<jigProtocol::MsgLive> > sink(this);
+    rxBuffer.consume(static_cast<int>(liveParser.complete(rxBuffer.readPtr(), rxBuffer.available(), sink)));
+}
+
+void serialPortHandler::processUnknown(bool endOfBurst)
+{
+    if(!endOfBurst)
+    {
+        return;
     }
 
+    //do nothing
+    qDebug()<<"do nothing not a specified size/unknown msgId";
+    executeWriteToNotes("Fatal Error 404");
+}
+
+void serialPortHandler::flushLiveBatch()
+{
+    if(batchCount == 0)
+    {
+        return;
+    }
+
+    frameBatch batch;
+    batch.sequence = batchSequence++;
+    batch.firstFrame = framesDelivered;
+    batch.frames = batchFrames.data();
+    batch.count = batchCount;
+
+    if(batchHandler)
+    {
+        batchHandler(batch);
+    }
+
+    const size_t pushed = liveFrames.push(batch.frames, static_cast<size_t>(batch.count));
+    if(pushed != static_cast<size_t>(batch.count))
+    {
+        //Reported through the summary; a warning per batch would only add to the backlog
+        ingestCounters::add(stats.droppedFrames, static_cast<quint64>(batch.count) - pushed);
+    }
+    ingestCounters::add(stats.validFrames, static_cast<quint64>(batch.count));
+
+    framesDelivered += static_cast<quint64>(batch.count);
+    batchCount = 0;
+
+    //Only wake the GUI if it has drained everything since the last notification
+    if(pushed > 0 && !liveNotifyPending.exchange(true, std::memory_order_acq_rel))
+    {
+        emit liveDataAvailable();
+    }
+}
+
+ingestSnapshot serialPortHandler::statistics() const
+{
+    return stats.snapshot(statsClock.nsecsElapsed(), liveFrames.size());
+}
+
+void serialPortHandler::resetStatistics()
+{
+    stats.reset();
+}
+
+void serialPortHandler::setFrameBatchHandler(const frameBatchHandler &handler)
+{
+    batchHandler = handler;
 }
 
 void serialPortHandler::recvMsgId(quint8 id)
 {
     qDebug() << "Received id:" <<hex<< id;
     this->id = id;
-    buffer.clear();
-    processedBytes = 0; //To ensure before clicking start processedBytes are re-setting.
+    recorder.recordMsgId(id);
+    rxBuffer.clear();
+    terminatorTimer->stop();
+    liveParser.reset(); //To ensure before clicking start the parsers are re-armed.
+    powerParser.reset();
+    batchCount = 0;
+    framesDelivered = 0;
+}
+
+void serialPortHandler::setReceiveCapacity(int bytes)
+{
+    QMutexLocker locker(&bufferMutex);
+    rxBuffer.setCapacity(bytes);
+}
+
+void serialPortHandler::startCapture(const QString &fileName)
+{
+    if(recorder.open(fileName))
+    {
+        //Replays need to know which framing was active when the first bytes arrive
+        recorder.recordMsgId(id);
+        emit executeWriteToNotes("Capture started: " + fileName);
+    }
+    else
+    {
+        qWarning() << "Cannot open capture file" << fileName << recorder.errorString();
+        emit executeWriteToNotes("Capture failed: " + fileName + " " + recorder.errorString());
+    }
+}
+
+void serialPortHandler::stopCapture()
+{
+    recorder.close();
+}
+
+void serialPortHandler::startReplay(const QString &fileName, double speed)
+{
+    if(!replay)
+    {
+        replay = new captureReplay(this);
+        //Direct: replay lives on this thread and hands out views of its own record
+        connect(replay, &captureReplay::bytesReplayed, this, &serialPortHandler::injectBytes, Qt::DirectConnection);
+        connect(replay, &captureReplay::msgIdReplayed, this, &serialPortHandler::recvMsgId, Qt::DirectConnection);
+        connect(replay, &captureReplay::finished, this, &serialPortHandler::replayFinished);
+    }
+
+    if(replay->start(fileName, speed))
+    {
+        emit executeWriteToNotes("Replay started: " + fileName + " speed " + QString::number(speed));
+    }
+    else
+    {
+        emit executeWriteToNotes("Replay failed: " + fileName);
+    }
+}
+
+void serialPortHandler::stopReplay()
+{
+    if(replay)
+    {
+        replay->stop();
+    }
 }
@@ -7,10 +7,34 @@
 #include <QDebug>
 #include <QMutexLocker>
 #include <QMutex>
-#include <QMessageBox>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "spscring.h"
+#include "jigprotocol.h"
+#include "frameparser.h"
+#include "receivebuffer.h"
+#include "ingeststats.h"
+#include "capturefile.h"
+#include "capturereplay.h"
+
+// Frames decoded from one read burst, as a contiguous span. The span is only
+// valid for the duration of the callback.
+struct frameBatch
+{
+    quint64 sequence;   //increments by one per batch, a gap means a lost batch
+    quint64 firstFrame; //stream index of frames[0] since the last start command
+    const liveFrame *frames;
+    int count;
+};
+
+typedef std::function<void(const frameBatch &)> frameBatchHandler;
 
 // Forward declaration of MainWindow
 class MainWindow;
+class asyncLogger;
 class serialPortHandler : public QObject
 {
     Q_OBJECT
@@ -18,6 +42,86 @@ public:
     explicit serialPortHandler(QObject *parent = nullptr);
      ~serialPortHandler();
 
+    QStringList availablePorts();
+
+    //Live frame hand-off to the GUI thread. The acquisition thread is the only
+    //producer, the GUI the only consumer. Call rearmLiveNotify() before draining
+    //so the next push raises liveDataAvailable() again.
+    spscRing<liveFrame> &liveRing() { return liveFrames; }
+    void rearmLiveNotify() { liveNotifyPending.store(false, std::memory_order_release); }
+
+    //Optional direct consumer, called on the acquisition thread once per read
+    //burst before the batch is pushed to liveRing(). Set it before the thread
+    //is started or from the acquisition thread itself.
+    void setFrameBatchHandler(const frameBatchHandler &handler);
+
+    //Binary event log for the verbose frame and hex dump notes, see eventlog.h.
+    //Set it before the thread is started; without one those notes are skipped.
+    void setEventLogger(asyncLogger *logger) { eventLogger = logger; }
+
+    //Ingest telemetry, callable from any thread
+    ingestSnapshot statistics() const;
+    void resetStatistics();
+
+    enum { MaxBatchFrames = 8192 }; //a longer burst is split into several batches
+
+    //DiagnosticsSummary keeps framing and decoding free of heap allocation and
+    //string building: per-burst and per-frame notes become counters, reported
+    //as one summary line per SummaryIntervalMs. DiagnosticsVerbose restores the
+    //old per-burst hex dumps and per-frame notes for bench debugging.
+    enum DiagnosticsMode
+    {
+        DiagnosticsSummary,
+        DiagnosticsVerbose
+    };
+    enum { SummaryIntervalMs = 1000 };
+
+    //The live terminator only ends the run once no bytes followed it for this
+    //long; the same bytes at a read boundary mid-run are just frame data
+    enum { TerminatorQuietMs = 50 };
+
+
+signals:
+
+    void portOpening(const QString &); //signal for dumping data from serialPortHandler to textEdit_RawBytes
+
+    void dataReceived();
+
+    void executeWriteToNotes(const QString &dataNotes);
+
+    void liveDataAvailable(); //raised once per drain cycle, not per frame
+    void plotCompleted();
+    void replayFinished();
+    void sendPowerData(const QVector<float> &data);
+
+private slots:
+
+    void readData();
+    void completeLiveRun();
+
+public slots:
+
+    void recvMsgId(quint8 id);
+
+    void setPORTNAME(const QString &portName);
+
+    //Memory ceiling for unread serial bytes, see receiveBuffer
+    void setReceiveCapacity(int bytes);
+
+    //Feeds bytes through the same framing path as a port read. Must be
+    //called on the acquisition thread.
+    void injectBytes(const char *data, int len);
+
+    //Raw capture of every port read (and msgId change) to a .lpcap file
+    void startCapture(const QString &fileName);
+    void stopCapture();
+
+    //Replays a .lpcap file through injectBytes(). speed 0 = as fast as possible
+    void startReplay(const QString &fileName, double speed);
+    void stopReplay();
+
+    void setDiagnosticsMode(int mode);
+
     void writeData(const QByteArray &data)
     {
         if(!serial->isOpen())
@@ -33,50 +137,71 @@ public:
         {
             if(serial->isOpen())
             {
-                buffer.clear();
+                rxBuffer.clear();
+                awaitingResponse = true;
                 serial->write(data);
             }
         }
     }
 
-    QStringList availablePorts();
-
-    void setPORTNAME(const QString &portName);
-
-    float convertBytesToFloat(const QByteArray &data);
+private:
+    //Per-layout consumers of frameParser, specialized in the .cpp
+    template<typename Layout> struct frameSink;
 
-    quint8 chkSum(const QByteArray &data);
+    //msgId -> parser for that layout. Called after every read of a burst and
+    //once more with endOfBurst set when the burst is complete.
+    typedef void (serialPortHandler::*burstFunction)(bool endOfBurst);
+    static const burstFunction *burstTable();
+    template<typename Layout> void processFrames(bool endOfBurst);
+    void processUnknown(bool endOfBurst);
 
+    void flushLiveBatch();
+    int receiveRoom() const;
+    void parseChunk();
+    void processBurst(quint64 droppedBefore, quint64 writtenBefore);
+    void reportSummary();
 
-signals:
+    bool verbose() const { return diagnostics == DiagnosticsVerbose; }
+    void logEvent(quint16 eventId, const uchar *data, int len);
 
-    void portOpening(const QString &); //signal for dumping data from serialPortHandler to textEdit_RawBytes
+    QSerialPort *serial;
+    receiveBuffer rxBuffer;
+    QTimer *terminatorTimer;
 
-    void dataReceived();
+    quint8 id = 0x00;
 
-    void executeWriteToNotes(const QString &dataNotes);
+    //dataReceived() is raised once per command, not once per burst
+    bool awaitingResponse = false;
 
-    void plotLiveData(QByteArray &data);
-    void sendPowerData(QVector<float> &data);
+    DiagnosticsMode diagnostics = DiagnosticsSummary;
+    QElapsedTimer summaryClock;
+    ingestSnapshot lastSummary;
 
-private slots:
-
-    void readData();
+    //mutex variable
+    QMutex bufferMutex; // Mutex for thread-safe access to the buffer
 
-public slots:
+    frameParser<jigProtocol::frameLayout<jigProtocol::MsgLive> > liveParser;
+    frameParser<jigProtocol::frameLayout<jigProtocol::MsgPower> > powerParser;
 
-    void recvMsgId(quint8 id);
+    spscRing<liveFrame> liveFrames;
+    std::atomic<bool> liveNotifyPending;
 
-private:
-    QSerialPort *serial;
-    QByteArray  buffer;
+    //Burst batch being filled by liveSink
+    std::vector<liveFrame> batchFrames;
+    int batchCount;
+    quint64 batchSequence;
+    quint64 framesDelivered;
+    frameBatchHandler batchHandler;
 
-    quint8 id;
+    ingestCounters stats;
+    QElapsedTimer statsClock;
+    quint64 burstParseNs = 0;
+    bool burstResynced = false;
 
-    //mutex variable
-    QMutex bufferMutex; // Mutex for thread-safe access to the buffer
+    captureRecorder recorder;
+    captureReplay *replay = nullptr;
 
-    static int processedBytes;
+    asyncLogger *eventLogger = nullptr;
 };
 
 #endif // SERIALPORTHANDLER_H
@@ -0,0 +1,104 @@
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <vector>
+#include <cstring>
+#include <type_traits>
+
+// Bounded single-producer/single-consumer ring used to hand decoded samples
+// from the acquisition thread to the GUI thread without locking.
+//
+// Exactly one thread may call push(), exactly one (other) thread may call
+// pop()/size(). Capacity is rounded up to a power of two. When the ring is
+// full push() stores as much as fits and reports the rest as dropped, so the
+// producer never blocks on a slow consumer.
+template<typename T>
+class spscRing
+{
+    static_assert(std::is_trivially_copyable<T>::value, "spscRing elements are copied with memcpy");
+
+public:
+    explicit spscRing(size_t capacity = 1 << 16)
+    {
+        size_t cap = 1;
+        while(cap < capacity)
+            cap <<= 1;
+        cells.resize(cap);
+        mask = cap - 1;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+    // Number of elements currently queued. Safe from any thread; from anywhere
+    // but the consumer it is a momentary estimate.
+    size_t size() const
+    {
+        //tail first: head can only have moved further by the time it is read
+        const size_t t = tail.load(std::memory_order_acquire);
+        return head.load(std::memory_order_acquire) - t;
+    }
+
+    // Producer side. Returns the number of elements actually stored.
+    size_t push(const T *items, size_t count)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        const size_t t = tail.load(std::memory_order_acquire);
+        const size_t room = capacity() - (h - t);
+        if(count > room)
+            count = room;
+        if(count == 0)
+            return 0;
+
+        const size_t first = qMin(count, capacity() - (h & mask));
+        memcpy(&cells[h & mask], items, first * sizeof(T));
+        if(count > first)
+            memcpy(&cells[0], items + first, (count - first) * sizeof(T));
+
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+
+    bool push(const T &item) { return push(&item, 1) == 1; }
+
+    // Consumer side. Copies up to maxCount elements into out and returns how
+    // many were taken.
+    size_t pop(T *out, size_t maxCount)
+    {
+        const size_t t = tail.load(std::memory_order_relaxed);
+        const size_t h = head.load(std::memory_order_acquire);
+        size_t count = h - t;
+        if(count > maxCount)
+            count = maxCount;
+        if(count == 0)
+            return 0;
+
+        const size_t first = qMin(count, capacity() - (t & mask));
+        memcpy(out, &cells[t & mask], first * sizeof(T));
+        if(count > first)
+            memcpy(out + first, &cells[0], (count - first) * sizeof(T));
+
+        tail.store(t + count, std::memory_order_release);
+        return count;
+    }
+
+private:
+    std::vector<T> cells;
+    size_t mask;
+
+    // Keep the producer and consumer indices on separate cache lines so the
+    // two threads do not keep invalidating each other. Padded rather than
+    // alignas(64): the ring lives inside heap-allocated objects, and C++11
+    // operator new does not honour extended alignment.
+    enum { CacheLineSize = 64 };
+    char padBeforeHead[CacheLineSize];
+    std::atomic<size_t> head; // written by producer only
+    char padBeforeTail[CacheLineSize - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> tail; // written by consumer only
+    char padAfterTail[CacheLineSize - sizeof(std::atomic<size_t>)];
+};
+
+#endif // SPSCRING_H
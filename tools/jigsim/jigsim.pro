@@ -0,0 +1,19 @@
+# Pseudo-terminal stand-in for the HighGTestJig, Linux only.
+# Build: qmake && make, then run ./jigsim --help
+
+QT       += core
+QT       -= gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = jigsim
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+SOURCES += \
+    jigsimulator.cpp \
+    main.cpp
+
+HEADERS += \
+    jigsimulator.h
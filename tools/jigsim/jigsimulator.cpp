@@ -0,0 +1,272 @@
+#include "jigsimulator.h"
+
+#include <QFile>
+#include <QTextStream>
+#include <cmath>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace
+{
+    const qint64 NsPerMs = 1000 * 1000;
+
+    //Inverse of serialPortHandler's power scaling, so the GUI shows these volts
+    quint16 powerRaw(float volts, bool tripled)
+    {
+        const float v = tripled ? volts / 3.0f : volts;
+        return static_cast<quint16>(qBound(0.0f, (v + 10.24f) * 4095.0f / 20.48f + 0.5f, 4095.0f));
+    }
+
+    void appendWord(QByteArray &out, quint16 word)
+    {
+        out.append(static_cast<char>(word >> 8));
+        out.append(static_cast<char>(word & 0xff));
+    }
+}
+
+jigSimulator::jigSimulator(const settings &config, QObject *parent) : QObject(parent)
+  , cfg(config)
+  , rng(std::random_device{}())
+  , unit(0.0, 1.0)
+{
+    streamTimer.setTimerType(Qt::PreciseTimer);
+    streamTimer.setInterval(1);
+    connect(&streamTimer, &QTimer::timeout, this, &jigSimulator::streamTick);
+
+    statsTimer.setInterval(1000);
+    connect(&statsTimer, &QTimer::timeout, this, &jigSimulator::printStats);
+}
+
+jigSimulator::~jigSimulator()
+{
+    if(!cfg.linkPath.isEmpty())
+    {
+        QFile::remove(cfg.linkPath);
+    }
+    if(slaveFd >= 0)
+    {
+        ::close(slaveFd);
+    }
+    if(masterFd >= 0)
+    {
+        ::close(masterFd);
+    }
+}
+
+bool jigSimulator::open()
+{
+    masterFd = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if(masterFd < 0 || ::grantpt(masterFd) != 0 || ::unlockpt(masterFd) != 0)
+    {
+        qCritical("posix_openpt failed: %s", strerror(errno));
+        return false;
+    }
+
+    slaveName = QString::fromLocal8Bit(::ptsname(masterFd));
+
+    //Hold the slave open ourselves so the pty survives clients coming and going,
+    //and make it raw so frames pass through untouched
+    slaveFd = ::open(slaveName.toLocal8Bit().constData(), O_RDWR | O_NOCTTY);
+    if(slaveFd < 0)
+    {
+        qCritical("Cannot open %s: %s", qPrintable(slaveName), strerror(errno));
+        return false;
+    }
+    termios tio;
+    ::tcgetattr(slaveFd, &tio);
+    ::cfmakeraw(&tio);
+    ::tcsetattr(slaveFd, TCSANOW, &tio);
+
+    if(!cfg.linkPath.isEmpty())
+    {
+        QFile::remove(cfg.linkPath);
+        if(!QFile::link(slaveName, cfg.linkPath))
+        {
+            qWarning("Cannot create link %s", qPrintable(cfg.linkPath));
+        }
+    }
+
+    readNotifier = new QSocketNotifier(masterFd, QSocketNotifier::Read, this);
+    //activated() is overloaded from Qt 5.15 on, the string form works across versions
+    connect(readNotifier, SIGNAL(activated(int)), this, SLOT(readCommands()));
+
+    statsTimer.start();
+    return true;
+}
+
+void jigSimulator::readCommands()
+{
+    char chunk[256];
+    ssize_t n;
+    while((n = ::read(masterFd, chunk, sizeof(chunk))) > 0)
+    {
+        commandBuffer.append(chunk, static_cast<int>(n));
+    }
+
+    //Commands are three bytes, anything that does not line up is skipped a byte at a time
+    while(commandBuffer.size() >= 3)
+    {
+        const uchar *c = reinterpret_cast<const uchar *>(commandBuffer.constData());
+        if(c[0] == 0xff && c[1] == 0x0a && c[2] == 0xff)
+        {
+            commandBuffer.remove(0, 3);
+            startRun();
+        }
+        else if(c[0] == 0x47 && c[1] == 0x01 && c[2] == (0x47 ^ 0x01))
+        {
+            commandBuffer.remove(0, 3);
+            sendPowerFrame();
+        }
+        else
+        {
+            commandBuffer.remove(0, 1);
+        }
+    }
+}
+
+void jigSimulator::startRun()
+{
+    QTextStream(stdout) << "start command: streaming " << (cfg.framesPerRun ? QString::number(cfg.framesPerRun) : QString("endless"))
+                        << " frames at " << cfg.framesPerSecond << " frames/s" << Qt::endl;
+    streaming = true;
+    framesSent = 0;
+    nextBurstNs = 0;
+    runClock.start();
+    streamTimer.start();
+}
+
+void jigSimulator::appendFrame(QByteArray &out)
+{
+    //Slow sine on the plotted word, counters on the other two
+    const double phase = 2.0 * M_PI * static_cast<double>(sampleIndex % 1000) / 1000.0;
+    const quint16 word0 = static_cast<quint16>(16384 + 12000 * std::sin(phase));
+    const int start = out.size();
+
+    appendWord(out, word0);
+    appendWord(out, static_cast<quint16>(sampleIndex));
+    appendWord(out, static_cast<quint16>(~sampleIndex));
+    ++sampleIndex;
+
+    if(cfg.corruptRate > 0.0 && unit(rng) < cfg.corruptRate)
+    {
+        const int at = start + static_cast<int>(unit(rng) * 6) % 6;
+        out[at] = static_cast<char>(out.at(at) ^ (1 << (rng() % 8)));
+    }
+    if(cfg.dropRate > 0.0 && unit(rng) < cfg.dropRate)
+    {
+        out.remove(start + static_cast<int>(rng() % 6), 1);
+    }
+}
+
+void jigSimulator::streamTick()
+{
+    if(!streaming)
+    {
+        streamTimer.stop();
+        return;
+    }
+
+    const qint64 now = runClock.nsecsElapsed();
+    qint64 due = static_cast<qint64>(cfg.framesPerSecond * now / 1e9);
+    if(cfg.framesPerRun > 0)
+    {
+        due = qMin(due, cfg.framesPerRun);
+    }
+
+    QByteArray out;
+    while(framesSent < due && now >= nextBurstNs)
+    {
+        const qint64 burst = qMin<qint64>(cfg.burstFrames, due - framesSent);
+        out.clear();
+        for(qint64 i = 0; i < burst; ++i)
+        {
+            appendFrame(out);
+        }
+        framesSent += burst;
+
+        if(!writeOut(out))
+        {
+            break;
+        }
+
+        if(cfg.jitterUs > 0)
+        {
+            nextBurstNs = now + static_cast<qint64>(unit(rng) * cfg.jitterUs * 1000.0);
+        }
+    }
+
+    if(cfg.framesPerRun > 0 && framesSent >= cfg.framesPerRun)
+    {
+        writeOut(QByteArray::fromHex("ffddff"));
+        streaming = false;
+        streamTimer.stop();
+        QTextStream(stdout) << "run complete: " << framesSent << " frames in "
+                            << runClock.nsecsElapsed() / NsPerMs << " ms" << Qt::endl;
+    }
+}
+
+void jigSimulator::sendPowerFrame()
+{
+    QByteArray frame;
+    frame.append(static_cast<char>(0x54));
+    frame.append(static_cast<char>(0x01));
+
+    const float volts[7] = {28.0f, 15.0f, -15.0f, 10.0f, 5.0f, -5.0f, 3.3f};
+    for(int i = 0; i < 7; ++i)
+    {
+        const float noisy = volts[i] * static_cast<float>(1.0 + (unit(rng) - 0.5) * 0.01);
+        appendWord(frame, powerRaw(noisy, i < 4));
+    }
+
+    quint8 chk = 0;
+    for(int i = 0; i < frame.size(); ++i)
+    {
+        chk ^= static_cast<quint8>(frame.at(i));
+    }
+    if(cfg.powerCorruptRate > 0.0 && unit(rng) < cfg.powerCorruptRate)
+    {
+        chk ^= 0x5a;
+    }
+    frame.append(static_cast<char>(chk));
+
+    writeOut(frame);
+}
+
+bool jigSimulator::writeOut(const QByteArray &data)
+{
+    const char *p = data.constData();
+    qint64 left = data.size();
+    while(left > 0)
+    {
+        const ssize_t n = ::write(masterFd, p, static_cast<size_t>(left));
+        if(n < 0)
+        {
+            if(errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                //The reader is not keeping up; a real UART would drop these bytes too
+                ++writeStalls;
+                return false;
+            }
+            qWarning("write failed: %s", strerror(errno));
+            return false;
+        }
+        bytesWritten += static_cast<quint64>(n);
+        p += n;
+        left -= n;
+    }
+    return true;
+}
+
+void jigSimulator::printStats()
+{
+    const quint64 delta = bytesWritten - bytesAtLastStats;
+    bytesAtLastStats = bytesWritten;
+    if(delta > 0 || streaming)
+    {
+        QTextStream(stdout) << delta << " B/s (" << delta * 10 << " baud equivalent), "
+                            << framesSent << " frames sent, " << writeStalls << " write stalls" << Qt::endl;
+    }
+}
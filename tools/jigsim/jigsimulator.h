@@ -0,0 +1,71 @@
+#ifndef JIGSIMULATOR_H
+#define JIGSIMULATOR_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QSocketNotifier>
+#include <QByteArray>
+#include <random>
+
+// Answers the LivePlotter commands on a Linux pty the way the jig does:
+//   ff 0a ff    -> a stream of 6-byte frames closed by ff dd ff
+//   47 01 chk   -> one 17-byte power frame 54 01 <7 x 16-bit> chk
+class jigSimulator : public QObject
+{
+    Q_OBJECT
+public:
+    struct settings
+    {
+        double framesPerSecond = 10000.0; //stream rate
+        qint64 framesPerRun = 20000;      //frames before the terminator, 0 = endless
+        int burstFrames = 32;             //frames per write() to the pty
+        int jitterUs = 0;                 //random extra delay before each burst
+        double corruptRate = 0.0;         //probability per frame of one flipped byte
+        double dropRate = 0.0;            //probability per frame of losing one byte
+        double powerCorruptRate = 0.0;    //probability a power frame gets a bad checksum
+        QString linkPath;                 //optional stable symlink to the slave side
+    };
+
+    explicit jigSimulator(const settings &config, QObject *parent = nullptr);
+    ~jigSimulator();
+
+    bool open();
+    QString slavePath() const { return slaveName; }
+
+private slots:
+    void readCommands();
+    void streamTick();
+    void printStats();
+
+private:
+    void startRun();
+    void sendPowerFrame();
+    void appendFrame(QByteArray &out);
+    bool writeOut(const QByteArray &data);
+
+    settings cfg;
+    int masterFd = -1;
+    int slaveFd = -1;
+    QString slaveName;
+    QSocketNotifier *readNotifier = nullptr;
+
+    QByteArray commandBuffer;
+
+    bool streaming = false;
+    qint64 framesSent = 0;
+    qint64 sampleIndex = 0;
+    qint64 nextBurstNs = 0;
+    QElapsedTimer runClock;
+    QTimer streamTimer;
+
+    QTimer statsTimer;
+    quint64 bytesWritten = 0;
+    quint64 bytesAtLastStats = 0;
+    quint64 writeStalls = 0;
+
+    std::mt19937 rng;
+    std::uniform_real_distribution<double> unit;
+};
+
+#endif // JIGSIMULATOR_H
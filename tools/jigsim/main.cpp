@@ -0,0 +1,66 @@
+#include "jigsimulator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QTextStream>
+#include <csignal>
+
+namespace
+{
+    void quitOnSignal(int)
+    {
+        QCoreApplication::quit();
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("jigsim");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("HighGTestJig simulator on a pseudo-terminal. "
+                                     "Attach LivePlotter with --port <slave path>.");
+    parser.addHelpOption();
+    QCommandLineOption rateOption("rate", "Live frames per second.", "frames", "10000");
+    QCommandLineOption framesOption("frames", "Frames per start command before ff dd ff, 0 = endless.", "count", "20000");
+    QCommandLineOption burstOption("burst", "Frames per write to the pty.", "frames", "32");
+    QCommandLineOption jitterOption("jitter", "Random extra delay before each burst.", "us", "0");
+    QCommandLineOption corruptOption("corrupt", "Probability per frame of a flipped bit.", "p", "0");
+    QCommandLineOption dropOption("drop", "Probability per frame of a lost byte.", "p", "0");
+    QCommandLineOption powerCorruptOption("power-corrupt", "Probability of a bad power frame checksum.", "p", "0");
+    QCommandLineOption linkOption("link", "Stable symlink to the slave side.", "path", "/tmp/ttyJIG0");
+    parser.addOption(rateOption);
+    parser.addOption(framesOption);
+    parser.addOption(burstOption);
+    parser.addOption(jitterOption);
+    parser.addOption(corruptOption);
+    parser.addOption(dropOption);
+    parser.addOption(powerCorruptOption);
+    parser.addOption(linkOption);
+    parser.process(a);
+
+    jigSimulator::settings config;
+    config.framesPerSecond = parser.value(rateOption).toDouble();
+    config.framesPerRun = parser.value(framesOption).toLongLong();
+    config.burstFrames = qMax(1, parser.value(burstOption).toInt());
+    config.jitterUs = parser.value(jitterOption).toInt();
+    config.corruptRate = parser.value(corruptOption).toDouble();
+    config.dropRate = parser.value(dropOption).toDouble();
+    config.powerCorruptRate = parser.value(powerCorruptOption).toDouble();
+    config.linkPath = parser.value(linkOption);
+
+    jigSimulator jig(config);
+    if(!jig.open())
+    {
+        return 1;
+    }
+
+    QTextStream(stdout) << "jig simulator on " << jig.slavePath()
+                        << (config.linkPath.isEmpty() ? QString() : " (" + config.linkPath + ")") << Qt::endl;
+
+    std::signal(SIGINT, quitOnSignal);
+    std::signal(SIGTERM, quitOnSignal);
+
+    return a.exec();
+}
@@ -0,0 +1,23 @@
+# Renders a LivePlotter binary event log (.lpevt) as debug_notes.txt style text.
+# Build: qmake && make, then run ./logdecode debug_events.lpevt
+
+QT       += core
+QT       -= gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = logdecode
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += ../..
+
+SOURCES += \
+    main.cpp \
+    ../../eventlog.cpp \
+    ../../logarchive.cpp
+
+HEADERS += \
+    ../../eventlog.h \
+    ../../logarchive.h
@@ -0,0 +1,111 @@
+#include "eventlog.h"
+#include "logarchive.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    QCoreApplication::setApplicationName("logdecode");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Prints a LivePlotter event log (.lpevt) in the debug_notes.txt format. "
+                                     "Rotated .qz archives are decompressed first, text segments are printed as they are.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("file", "Event log or .qz archive to decode.");
+    QCommandLineOption outputOption("output", "Write to this file instead of stdout.", "file");
+    QCommandLineOption payloadOption("payload", "Append the raw payload bytes in hex to every line.");
+    QCommandLineOption monotonicOption("monotonic", "Print seconds on the monotonic clock instead of wall time.");
+    parser.addOption(outputOption);
+    parser.addOption(payloadOption);
+    parser.addOption(monotonicOption);
+    parser.process(a);
+
+    const QStringList files = parser.positionalArguments();
+    if(files.size() != 1)
+    {
+        parser.showHelp(1);
+    }
+
+    const QString fileName = files.first();
+    QBuffer unpacked;
+    const bool archive = fileName.endsWith(logArchive::Suffix);
+    if(archive)
+    {
+        unpacked.open(QIODevice::ReadWrite);
+        if(!logArchive::decompress(fileName, &unpacked))
+        {
+            QTextStream(stderr) << "Not a log archive: " << fileName << Qt::endl;
+            return 1;
+        }
+        unpacked.seek(0);
+    }
+
+    //A compressed debug_notes segment is plain text and is printed as it is
+    const bool events = !archive || unpacked.data().startsWith(QByteArray(eventLog::Magic, sizeof(eventLog::Magic)));
+
+    eventLogReader reader;
+    if(events && !(archive ? reader.open(&unpacked) : reader.open(fileName)))
+    {
+        QTextStream(stderr) << "Not an event log: " << fileName << Qt::endl;
+        return 1;
+    }
+
+    QFile outFile;
+    if(parser.isSet(outputOption))
+    {
+        outFile.setFileName(parser.value(outputOption));
+        if(!outFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            QTextStream(stderr) << "Cannot write " << outFile.fileName() << ": " << outFile.errorString() << Qt::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        outFile.open(stdout, QIODevice::WriteOnly);
+    }
+    QTextStream out(&outFile);
+
+    if(!events)
+    {
+        outFile.write(unpacked.data());
+        return 0;
+    }
+
+    const bool payload = parser.isSet(payloadOption);
+    const bool monotonic = parser.isSet(monotonicOption);
+
+    eventLog::record r;
+    quint64 count = 0;
+    while(reader.next(r))
+    {
+        QString stamp;
+        if(monotonic)
+        {
+            stamp = QString::number(r.timestampNs / 1e9, 'f', 9);
+        }
+        else
+        {
+            const qint64 wallMs = reader.startedMs() + static_cast<qint64>(r.timestampNs / 1000000);
+            stamp = QDateTime::fromMSecsSinceEpoch(wallMs).toString("yyyy-MM-dd HH:mm:ss.zzz");
+        }
+
+        out << "[" << stamp << "] " << eventLog::describe(r);
+        if(payload)
+        {
+            out << " | " << QByteArray(reinterpret_cast<const char *>(r.payload), r.storedLength()).toHex(' ');
+        }
+        out << '\n';
+        ++count;
+    }
+    out.flush();
+
+    QTextStream(stderr) << count << " events" << Qt::endl;
+    return 0;
+}